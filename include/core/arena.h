@@ -0,0 +1,22 @@
+#ifndef BUH_CORE_ARENA_H
+#define BUH_CORE_ARENA_H
+
+#include <stddef.h>
+
+#define ARENA_ALIGN 16
+
+/* Bump allocator over one block. An arena with no block only counts, so a
+   layout can be measured with the same code that later carves it. */
+typedef struct {
+  unsigned char *base;
+  size_t size;
+  size_t used;
+} Arena;
+
+int arena_init(Arena *a, size_t size);
+void *arena_alloc(Arena *a, size_t size);
+void arena_free(Arena *a);
+
+#define ARENA_NEW(a, T, n) ((T *)arena_alloc((a), sizeof(T) * (size_t)(n)))
+
+#endif
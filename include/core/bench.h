@@ -0,0 +1,17 @@
+#ifndef BUH_CORE_BENCH_H
+#define BUH_CORE_BENCH_H
+
+#include "core/game.h"
+
+typedef struct {
+  int ticks;
+  int enemies;
+  int hw_counters;
+  int crowd; /* 0 runs with enemy separation off */
+  unsigned int seed;
+} BenchOptions;
+
+int bench_parse_args(BenchOptions *o, int argc, char **argv);
+int run_benchmark(Game *g, const BenchOptions *o);
+
+#endif
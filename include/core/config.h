@@ -1,12 +1,17 @@
 #ifndef BUH_CORE_CONFIG_H
 #define BUH_CORE_CONFIG_H
 
-#define MAX_WEAPONS 32
-#define MAX_ITEMS 128
-#define MAX_ENEMIES 2048
-#define MAX_BULLETS 512
-#define MAX_DROPS 256
+/* Enemy, bullet and drop pools are sized at startup (core/pools.h). */
+#define ENEMY_CAP_LIMIT 65536 /* hit-set keys pack the slot into 16 bits */
+#define BULLET_LIFETIME 2.2f
+#define DROP_MERGE_RADIUS 40.0f /* a new XP orb folds into a resting one this close */
+#define DROP_XP_BASE_VALUE 2.0f
+#define DROP_XP_MAX_SCALE 2.5f
+#define DROP_MAGNET_ACCEL 400.0f
+#define DROP_MAGNET_MAX_SPEED 600.0f
+#define DROP_MAGNET_CHUNK 256
 #define MAX_WEAPON_SLOTS 6
+#define MAX_PASSIVE_ITEMS 128
 #define MAX_WEAPON_LEVEL 4
 #define MAX_SHOP_SLOTS 12
 #define MAX_PUDDLES 64
@@ -30,5 +35,75 @@
 #define MAX_SKILL_TREE_CUSTOM_NODES 64
 #define MAX_TOTEMS 4
 
+#define GROUND_TILE_SIZE 128
+#define GROUND_DECAL_SIZE 64
+#define MAX_GROUND_VARIANTS 4
+#define MAX_GROUND_DECALS 8
+#define MAX_ASSETS 128
+
+/* Enemy update LOD: distance from the player where each bucket starts.
+   Bucket b updates every 2^b ticks. */
+#define ENEMY_LOD_BUCKETS 4
+#define ENEMY_LOD_NEAR 900.0f
+#define ENEMY_LOD_MID 1800.0f
+#define ENEMY_LOD_FAR 3200.0f
+
+/* Uniform grid over the arena used for enemy broadphase queries. */
+#define ENEMY_RADIUS 16.0f
+#define ENEMY_GRID_CELL 128
+#define ENEMY_GRID_COLS ((ARENA_W + ENEMY_GRID_CELL - 1) / ENEMY_GRID_CELL)
+#define ENEMY_GRID_ROWS ((ARENA_H + ENEMY_GRID_CELL - 1) / ENEMY_GRID_CELL)
+#define ENEMY_GRID_SLACK 32.0f /* knockback allowance for queries between rebuilds */
+#define MAX_SWEEP_HITS 32
+
+/* Crowd separation: overlapping enemies push apart, at a bounded cost each. */
+#define CROWD_RADIUS 28.0f
+#define CROWD_CELL 32.0f /* >= CROWD_RADIUS: a radius spans at most 3x3 cells */
+#define CROWD_GRID_COLS ((int)(ARENA_W / CROWD_CELL) + 1)
+#define CROWD_GRID_ROWS ((int)(ARENA_H / CROWD_CELL) + 1)
+#define CROWD_STRENGTH 240.0f /* px/s from one fully overlapping neighbour */
+#define CROWD_MAX_STEP 4.0f   /* px per tick */
+#define CROWD_MAX_SCAN 32       /* a few times the usual 6-8 neighbours */
+#define CROWD_TICK_ENEMIES 384  /* more than this take turns... */
+#define CROWD_MAX_STRIDE 16     /* ...up to one turn in sixteen ticks */
+#define CROWD_SCAN_PAD 3        /* slack after the sorted arrays for 4-wide loads */
+
+/* Shared per-tick target acquisition. */
+#define TARGET_KNN 6
+#define HOMING_RANGE 1000.0f
+#define HOMING_RETARGET_INTERVAL 0.2f
+
+/* Area-effect field: puddles and auras stamp into cells, enemies sample
+   their cell once per tick. */
+#define FIELD_CELL 64
+#define FIELD_COLS ((ARENA_W + FIELD_CELL - 1) / FIELD_CELL)
+#define FIELD_ROWS ((ARENA_H + FIELD_CELL - 1) / FIELD_CELL)
+#define FIELD_EDGE_CAP 8192
+
+/* Chain procs queued during a tick and resolved together. */
+#define MAX_CHAIN_PROCS 64
+
+/* Per-projectile hit sets: a few inline entries, then a pooled bitmap. */
+#define HIT_SET_INLINE 6
+#define MAX_HIT_OVERFLOW 32
+
+/* Spawn director: a data-defined curve of phases, each emitting batches. */
+#define MAX_SPAWN_PHASES 16
+#define MAX_SPAWN_PHASE_ENEMIES 8
+#define MAX_SPAWN_BATCH 128
+#define SPAWN_RING_SLOTS 64 /* power of two: ring slots wrap with a mask */
+#define SPAWN_MIN_INTERVAL 0.05f
+#define SPAWN_EDGE_MARGIN 20.0f
+#define SPAWN_SWARM_RADIUS 90.0f
+
+/* Per-tick and per-frame scratch: a fixed part plus room for this many
+   caps.enemies-sized index lists. */
+#define TICK_SCRATCH_BASE_BYTES (64 * 1024)
+#define TICK_SCRATCH_ENEMY_LISTS 4
+#define FRAME_SCRATCH_BASE_BYTES (16 * 1024)
+#define FRAME_SCRATCH_ENEMY_LISTS 3
+#define RENDER_CULL_MARGIN 128.0f
+#define INTERP_SNAP_DIST 160.0f /* a bigger move in one tick is a teleport: draw it in place */
+
 #endif
 
@@ -13,8 +13,46 @@
 #include <time.h>
 #include <windows.h>
 
+#include "core/arena.h"
 #include "core/config.h"
+#include "core/scratch.h"
 #include "core/types.h"
+#include "render/assets.h"
+#include "render/ground.h"
+
+/* Fixed sprites the renderer draws by slot; ids resolve through data/assets.json. */
+typedef enum {
+  TEX_HEALTH_FLASK,
+  TEX_ENEMY,
+  TEX_ENEMY_EYE,
+  TEX_ENEMY_GHOST,
+  TEX_ENEMY_CHARGER,
+  TEX_BOSS,
+  TEX_PLAYER_FRONT,
+  TEX_PLAYER_BACK,
+  TEX_PLAYER_RIGHT,
+  TEX_PLAYER_LEFT,
+  TEX_ENEMY_BOLT,
+  TEX_LIGHTNING_ZONE,
+  TEX_CHEST,
+  TEX_LASER_BEAM,
+  TEX_SCYTHE,
+  TEX_BITE,
+  TEX_DAGGER,
+  TEX_ALCHEMIST_PUDDLE,
+  TEX_FIRE_TRAIL,
+  TEX_ALCHEMIST_ULT,
+  TEX_EXP_ORB,
+  TEX_ORB_COMMON,
+  TEX_ORB_UNCOMMON,
+  TEX_ORB_RARE,
+  TEX_ORB_EPIC,
+  TEX_ORB_LEGENDARY,
+  TEX_TOTEM_FREEZE,
+  TEX_TOTEM_CURSE,
+  TEX_TOTEM_DAMAGE,
+  TEX_COUNT
+} TextureId;
 
 typedef struct {
   int type; /* 0 item, 1 weapon */
@@ -33,46 +71,20 @@ typedef struct {
   int window_h;
   int view_w;
   int view_h;
-  SDL_Texture *tex_ground;
-  SDL_Texture *tex_wall;
-  SDL_Texture *tex_health_flask;
-  SDL_Texture *tex_enemy;
-  SDL_Texture *tex_enemy_eye;
-  SDL_Texture *tex_enemy_ghost;
-  SDL_Texture *tex_enemy_charger;
-  SDL_Texture *tex_boss;
-  SDL_Texture *tex_player;
-  SDL_Texture *tex_player_front;
-  SDL_Texture *tex_player_back;
-  SDL_Texture *tex_player_right;
-  SDL_Texture *tex_player_left;
-  SDL_Texture *tex_character_walk[MAX_CHARACTERS];
-  SDL_Texture *tex_enemy_bolt;
-  SDL_Texture *tex_lightning_zone;
-  SDL_Texture *tex_chest;
-  SDL_Texture *tex_laser_beam;
-  SDL_Texture *tex_portraits[MAX_CHARACTERS];
-  SDL_Texture *tex_scythe;
-  SDL_Texture *tex_bite;
-  SDL_Texture *tex_dagger;
-  SDL_Texture *tex_alchemist_puddle;
-  SDL_Texture *tex_fire_trail;
-  SDL_Texture *tex_alchemist_ult;
-  SDL_Texture *tex_exp_orb;
-  SDL_Texture *tex_orb_common;
-  SDL_Texture *tex_orb_uncommon;
-  SDL_Texture *tex_orb_rare;
-  SDL_Texture *tex_orb_epic;
-  SDL_Texture *tex_orb_legendary;
-  SDL_Texture *tex_totem_freeze;
-  SDL_Texture *tex_totem_curse;
-  SDL_Texture *tex_totem_damage;
+  GroundLayer ground;
+  AssetRegistry assets;
+  AssetHandle tex[TEX_COUNT];
+  AssetHandle tex_walk[MAX_CHARACTERS];
+  AssetHandle tex_portrait[MAX_CHARACTERS];
+  AssetHandle run_walk; /* walk strip held for the current run */
+  int menu_assets_held;
   int running;
   GameMode mode;
   GameMode pause_return_mode;
   float time_scale;
   int debug_show_range;
   int debug_show_items;
+  int debug_show_profiler;
   float ultimate_cd;
   int start_page;
   float start_scroll;
@@ -86,12 +98,31 @@ typedef struct {
 
   Database db;
   Player player;
-  Enemy enemies[MAX_ENEMIES];
-  Bullet bullets[MAX_BULLETS];
-  Drop drops[MAX_DROPS];
+  /* Entity pools live in pool_arena, sized by caps; see core/pools.h. */
+  GameCaps caps;
+  Arena pool_arena;
+  Scratch tick_scratch;  /* reset by update_game / update_boss_event */
+  Scratch frame_scratch; /* reset by render_game */
+  Enemy *enemies;
+  int enemy_alloc_cursor; /* next slot spawn scans from */
+  Bullet *bullets;
+  BulletRing bullet_ring;
+  EnemyBullet *enemy_bullets;
+  int enemy_bullet_count;
+  Drop *drops;
+  DropStats drop_stats;
   Puddle puddles[MAX_PUDDLES];
   Totem totems[MAX_TOTEMS];
   WeaponFX weapon_fx[MAX_WEAPON_FX];
+  DebuffSystem debuffs;
+  EnemyGrid enemy_grid;
+  Targeting targeting;
+  DamageField field;
+  ChainProc chain_procs[MAX_CHAIN_PROCS];
+  int chain_proc_count;
+  unsigned int *chain_mark; /* == chain_stamp when the current chain visited it */
+  unsigned int chain_stamp;
+  HitOverflow hit_overflow[MAX_HIT_OVERFLOW];
   Boss boss;
   int boss_def_index;
   float boss_event_cd;
@@ -101,6 +132,7 @@ typedef struct {
   float boss_room_x;
   float boss_room_y;
   WaveSnapshot wave_snapshot;
+  RenderInterp interp;
   SkillTreeProgress skill_tree;
   int skill_tree_points_earned_last;
   int skill_tree_run_awarded;
@@ -138,6 +170,15 @@ typedef struct {
   float skill_tree_armor_bonus;
 
   float spawn_timer;
+  SpawnDirector director;
+  unsigned int enemy_lod_tick;
+  int enemy_lod_counts[ENEMY_LOD_BUCKETS]; /* active enemies per bucket, last tick */
+  int enemy_lod_updates;                   /* enemies fully updated last tick */
+  int crowd_disabled;                      /* F8: skip enemy separation */
+  int headless;                            /* --bench: a death never awards or saves skill points */
+  int crowd_neighbors;                     /* neighbours weighed by separation last tick */
+  int crowd_pushed;                        /* enemies whose push was refreshed last tick */
+  CrowdGrid crowd_grid;
   int kills;
   int xp;
   int level;
@@ -153,7 +194,6 @@ typedef struct {
   SDL_Rect highroll_button;
   SDL_Rect restart_button;
   SDL_Rect pause_end_run_button;
-  int scythe_id_counter;
   float camera_x;
   float camera_y;
   float totem_spawn_timer;
@@ -172,6 +212,14 @@ void log_linef(const char *fmt, ...);
 void log_combatf(Game *g, const char *fmt, ...);
 
 SDL_Texture *load_texture_fallback(SDL_Renderer *r, const char *path);
+int game_assets_init(Game *g, SDL_Renderer *r);
+void game_assets_bind_characters(Game *g);
+const char *game_tex_id(TextureId id);
+SDL_Texture *game_tex(Game *g, TextureId id);
+SDL_Texture *game_walk_tex(Game *g, int char_idx);
+SDL_Texture *game_portrait_tex(Game *g, int char_idx);
+void game_assets_enter_menu(Game *g);
+void game_assets_enter_run(Game *g);
 LONG WINAPI crash_handler(EXCEPTION_POINTERS *e);
 
 float clampf(float v, float a, float b);
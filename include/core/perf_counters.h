@@ -0,0 +1,26 @@
+#ifndef BUH_CORE_PERF_COUNTERS_H
+#define BUH_CORE_PERF_COUNTERS_H
+
+#include <SDL.h>
+
+typedef enum {
+  HW_CYCLES,
+  HW_INSTRUCTIONS,
+  HW_CACHE_MISSES,
+  HW_BRANCH_MISSES,
+  HW_COUNTER_COUNT
+} HwCounter;
+
+typedef struct {
+  Uint64 v[HW_COUNTER_COUNT];
+} HwSample;
+
+/* Returns a bitmask of counters that could be opened (bit = 1 << HwCounter),
+   0 when the platform or permissions give us nothing. */
+int hw_counters_open(void);
+void hw_counters_close(void);
+int hw_counters_available(void);
+void hw_counters_read(HwSample *out);
+const char *hw_counter_name(int c);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef BUH_CORE_POOLS_H
+#define BUH_CORE_POOLS_H
+
+#include "core/game.h"
+
+#define POOL_PROFILE_DEFAULT "medium"
+
+int game_caps_profile(const char *name, GameCaps *out);
+int game_pools_init(Game *g, const GameCaps *caps);
+void game_pools_free(Game *g);
+
+static inline int hit_overflow_words(const Game *g) {
+  return (g->caps.enemies + 31) / 32;
+}
+
+#endif
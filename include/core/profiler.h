@@ -0,0 +1,79 @@
+#ifndef BUH_CORE_PROFILER_H
+#define BUH_CORE_PROFILER_H
+
+#include <SDL.h>
+
+#include "core/perf_counters.h"
+
+#define PROF_HISTORY 240
+#define PROF_TRACE_EVENTS 16384
+#define PROF_TRACE_SECONDS 10.0
+
+typedef enum {
+  PROF_SIM_TICK,
+  PROF_FIRE_WEAPONS,
+  PROF_UPDATE_BULLETS,
+  PROF_UPDATE_ENEMY_BULLETS,
+  PROF_UPDATE_WEAPON_FX,
+  PROF_UPDATE_PUDDLES,
+  PROF_UPDATE_DEBUFFS,
+  PROF_UPDATE_ENEMIES,
+  PROF_CROWD,
+  PROF_PICKUPS,
+  PROF_RENDER_WORLD,
+  PROF_RENDER_UI,
+  PROF_PRESENT,
+  PROF_ZONE_COUNT
+} ProfZone;
+
+/* One committed frame: per-zone time summed over every sim tick that ran in it. */
+typedef struct {
+  float frame_ms;
+  float zone_ms[PROF_ZONE_COUNT];
+  int sim_ticks;
+} ProfFrame;
+
+/* Raw span kept for trace export; zone == PROF_ZONE_COUNT marks a whole frame. */
+typedef struct {
+  Uint64 start;
+  Uint64 end;
+  int zone;
+  int ticks;
+} ProfEvent;
+
+typedef struct {
+  ProfFrame frames[PROF_HISTORY];
+  int head; /* slot the next committed frame goes to */
+  int count;
+  Uint64 zone_start[PROF_ZONE_COUNT];
+  Uint64 zone_accum[PROF_ZONE_COUNT];
+  int sim_ticks;
+  Uint64 last_frame;
+  double ms_per_count;
+  Uint64 origin;
+  ProfEvent events[PROF_TRACE_EVENTS];
+  int event_head;
+  int event_count;
+  /* Whole-run totals; hardware counters only move while hw_enabled (benchmark). */
+  Uint64 zone_total[PROF_ZONE_COUNT];
+  int zone_calls[PROF_ZONE_COUNT];
+  int hw_enabled;
+  HwSample hw_start[PROF_ZONE_COUNT];
+  Uint64 hw_total[PROF_ZONE_COUNT][HW_COUNTER_COUNT];
+} Profiler;
+
+extern Profiler g_prof;
+
+void prof_init(void);
+void prof_begin(ProfZone z);
+void prof_end(ProfZone z);
+void prof_frame_end(void);
+const char *prof_zone_name(ProfZone z);
+const ProfFrame *prof_frame_at(int age);
+void prof_zone_stats(ProfZone z, float *avg_ms, float *max_ms);
+void prof_frame_stats(float *avg_ms, float *max_ms);
+int prof_write_trace(const char *path);
+int prof_hw_enable(void);
+void prof_hw_disable(void);
+
+#endif
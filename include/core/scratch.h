@@ -0,0 +1,45 @@
+#ifndef BUH_CORE_SCRATCH_H
+#define BUH_CORE_SCRATCH_H
+
+#include "core/arena.h"
+
+#define SCRATCH_MAX_SPILLS 32
+
+/* Linear scratch for data that lives one tick or one frame. The owner
+   resets it at the start of update_game / render_game; nothing is freed
+   individually, though a caller can rewind to a mark it took. A request past
+   the end of the block falls back to the heap (a spill), is released on the
+   next reset and counted so the block can be resized. */
+typedef struct {
+  Arena arena;
+  void *spills[SCRATCH_MAX_SPILLS];
+  int spill_count;
+  int spills_total; /* spills since startup */
+  size_t high_water; /* largest use seen in one tick or frame */
+} Scratch;
+
+void scratch_reset(Scratch *s);
+void *scratch_alloc(Scratch *s, size_t size);
+void scratch_free(Scratch *s);
+
+static inline size_t scratch_mark(const Scratch *s) {
+  return s->arena.used;
+}
+
+static inline void scratch_release(Scratch *s, size_t mark) {
+  if (mark < s->arena.used) s->arena.used = mark;
+}
+
+#define SCRATCH_NEW(s, T, n) ((T *)scratch_alloc((s), sizeof(T) * (size_t)(n)))
+
+/* Heap allocations made while the simulation tick runs are counted; with
+   BUH_ALLOC_CHECKS defined they also trip an assertion. BUH_ALLOC_WRAP builds
+   see every malloc/calloc/realloc; otherwise only the noted call sites. */
+void alloc_guard_enter(void);
+void alloc_guard_leave(void);
+void alloc_guard_note(const char *what);
+int alloc_guard_hits(void);
+/* Tests turn the assertion off to count hits instead; returns the old setting. */
+int alloc_guard_set_fatal(int fatal);
+
+#endif
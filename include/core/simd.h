@@ -0,0 +1,21 @@
+#ifndef BUH_CORE_SIMD_H
+#define BUH_CORE_SIMD_H
+
+/* SSE2 paths: always on x86-64, opt-in on 32-bit x86. Every vector loop
+   keeps a scalar tail or fallback for other targets. */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BUH_SSE2 1
+#endif
+
+#ifdef BUH_SSE2
+/* 1/sqrt(v): the rsqrt estimate plus one Newton step, close to full float
+   precision and plenty for steering and pushes. v must be > 0. */
+static inline __m128 rsqrt_nr(__m128 v) {
+  __m128 r = _mm_rsqrt_ps(v);
+  __m128 three_minus = _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(v, _mm_mul_ps(r, r)));
+  return _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), r), three_minus);
+}
+#endif
+
+#endif
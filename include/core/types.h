@@ -145,7 +145,7 @@ typedef struct {
   Stats base;
   Stats bonus;
   WeaponSlot weapons[MAX_WEAPON_SLOTS];
-  int passive_items[MAX_ITEMS];
+  int passive_items[MAX_PASSIVE_ITEMS];
   int passive_count;
   float ultimate_move_to_as_timer;
   float move_dir_x;
@@ -179,16 +179,25 @@ typedef struct {
   float safe_y[3];
 } Boss;
 
+/* Timed enemy effects, including per-enemy hit cooldowns; see systems/debuffs.h. */
+typedef enum {
+  DEBUFF_BURN,
+  DEBUFF_BLEED,
+  DEBUFF_SLOW,
+  DEBUFF_STUN,
+  DEBUFF_ARMOR_SHRED,
+  DEBUFF_CURSE,
+  DEBUFF_MOLTEN_CD,
+  DEBUFF_SWORD_CD,
+  DEBUFF_SPAWN_INVULN,
+  DEBUFF_KIND_COUNT
+} DebuffKind;
+
 typedef struct {
-  float burn_timer;
-  float bleed_timer;
+  float until[DEBUFF_KIND_COUNT]; /* debuff clock time each effect ends */
+  unsigned int mask;              /* kinds applied and not yet expired by the wheel */
   int bleed_stacks;
-  float slow_timer;
-  float stun_timer;
-  float armor_shred_timer;
-  float curse_timer;
   float curse_dps;
-  float molten_tick_cd;
 } EnemyDebuffs;
 
 typedef struct {
@@ -198,38 +207,152 @@ typedef struct {
   float y;
   float vx;
   float vy;
+  float crowd_vx; /* separation push, refreshed on this enemy's crowd turn */
+  float crowd_vy;
   float hp;
   float max_hp;
-  float spawn_invuln;
   float cooldown;
   float charge_timer;
   float charge_time;
   EnemyDebuffs debuffs;
   float hit_timer;
-  float sword_hit_cd;
-  int scythe_hit_id;
+  float lod_dt; /* time not yet simulated while in a reduced-rate bucket */
+  unsigned int gen; /* bumped each time the slot is reused */
 } Enemy;
 
+/* Enemies already struck by one projectile or effect. Inline keys pack
+   slot and generation; past HIT_SET_INLINE the set borrows a bitmap from
+   Game.hit_overflow (index + 1, 0 = none). */
+typedef struct {
+  unsigned int keys[HIT_SET_INLINE];
+  unsigned char count;
+  unsigned char ring;
+  short overflow;
+} HitSet;
+
+typedef struct {
+  int in_use;
+  unsigned int *bits; /* one bit per enemy slot, carved from the pool arena */
+} HitOverflow;
+
+/* Player projectile: the per-shot data collisions need. Motion lives in
+   BulletRing at the same index. */
 typedef struct {
   int active;
-  int from_player;
-  float x;
-  float y;
-  float vx;
-  float vy;
   float damage;
   float radius;
-  float lifetime;
   int pierce;
   int homing;
+  int home_target; /* enemy slot being steered toward, -1 if none */
+  unsigned int home_gen;
+  float retarget_timer;
   int weapon_index;
   float bleed_chance;
   float burn_chance;
   float slow_chance;
   float stun_chance;
   float armor_shred_chance;
+  HitSet hits;
+  int hit_boss;
 } Bullet;
 
+#define BULLET_EXPIRED 1
+#define BULLET_OUTSIDE 2
+
+/* Player shot motion in SoA form. Every shot gets the same lifetime, so
+   they expire in spawn order: slots are handed out at tail and reclaimed
+   by advancing head. head and tail count up forever; index = n & mask,
+   the capacity being a power of two. */
+typedef struct {
+  float *x;
+  float *y;
+  float *px; /* position before this tick's step, for swept tests */
+  float *py;
+  float *vx;
+  float *vy;
+  float *life;
+  unsigned char *flags;
+  unsigned int mask;
+  unsigned int head;
+  unsigned int tail;
+} BulletRing;
+
+/* Enemy and boss shots only move, expire and hit the player. */
+typedef struct {
+  float x;
+  float y;
+  float vx;
+  float vy;
+  float damage;
+  float lifetime;
+} EnemyBullet;
+
+/* Active enemies bucketed by grid cell: cell c owns
+   items[cell_start[c] .. cell_start[c + 1]). */
+typedef struct {
+  int cell_start[ENEMY_GRID_COLS * ENEMY_GRID_ROWS + 1];
+  int *items; /* one per enemy slot */
+  int count;
+} EnemyGrid;
+
+/* Active enemies counting-sorted into CROWD_CELL cells over the horde's
+   bounding box, row-major: cell c owns sorted entries
+   [start[c], start[c + 1]). Rebuilt at the start of each round of turns. */
+typedef struct {
+  int *start;
+  int *ids;  /* slot per sorted entry */
+  int *cell; /* cell per sorted entry */
+  unsigned int *gen;
+  float *x;
+  float *y;
+  int count;
+  int cols;
+  int rows;
+  int stride; /* turns in this round */
+  int turn;   /* next turn; 0 rebuilds the grid */
+} CrowdGrid;
+
+typedef struct {
+  int enemy;
+  float t; /* fraction of the swept segment where contact begins */
+} SweepHit;
+
+/* Coarse area-effect grid, heap-allocated on first use. Cells wholly
+   inside a source accumulate it directly; cells a source only partly
+   covers list it as an edge entry and enemies there test it exactly. */
+typedef struct {
+  float *dps;        /* plain puddles covering the whole cell */
+  float *molten_dps; /* strongest molten puddle covering the whole cell */
+  unsigned char *flags;
+  int *edge_head;    /* 1-based into edge_src/edge_next, 0 = none */
+  int *edge_src;     /* puddle index, or FIELD_SRC_* for auras */
+  int *edge_next;
+  int edge_count;
+  int *touched;      /* cells stamped this tick, cleared on the next build */
+  int touched_count;
+  int log_due;
+} DamageField;
+
+typedef struct {
+  int start; /* enemy the proc fired on */
+  unsigned int start_gen;
+  float damage;
+  int bounces;
+  float range;
+} ChainProc;
+
+/* Targets every weapon shares for one tick; only enemies that can be hit
+   (active, not spawn-invulnerable) are considered. */
+typedef struct {
+  int nearest; /* closest to the player, -1 if none */
+  float nearest_d2;
+  int knn[TARGET_KNN]; /* the closest few, nearest first */
+  float knn_d2[TARGET_KNN];
+  int knn_count;
+  int *onscreen; /* one per enemy slot */
+  int onscreen_count;
+} Targeting;
+
 typedef struct {
   int active;
   int type; /* 0 xp orb, 1 heal, 2 chest */
@@ -241,6 +364,50 @@ typedef struct {
   int magnetized;
 } Drop;
 
+/* Entity pool sizes, picked from a performance profile at startup. */
+typedef struct {
+  int enemies;
+  int bullets; /* power of two: the bullet ring wraps with a mask */
+  int enemy_bullets;
+  int drops;
+} GameCaps;
+
+typedef enum {
+  SPAWN_EDGE = 1 << 0,  /* each enemy just outside a random camera edge */
+  SPAWN_RING = 1 << 1,  /* evenly spaced circle around the player, off screen */
+  SPAWN_SWARM = 1 << 2, /* tight cluster at one off-screen point */
+  SPAWN_LINE = 1 << 3   /* wall marching in along one edge */
+} SpawnPattern;
+
+/* One keyframe of the difficulty curve; interval and batch ease toward the
+   next phase, enemy ids are resolved per batch. */
+typedef struct {
+  float start;
+  float interval;
+  int batch;
+  unsigned int patterns; /* SpawnPattern bits, one picked per batch */
+  char enemies[MAX_SPAWN_PHASE_ENEMIES][32];
+  int enemy_count; /* 0 means any def */
+} SpawnPhase;
+
+typedef struct {
+  SpawnPhase phases[MAX_SPAWN_PHASES];
+  int phase_count; /* 0 falls back to the built-in curve */
+  float ring_cos[SPAWN_RING_SLOTS];
+  float ring_sin[SPAWN_RING_SLOTS];
+  int ring_ready;
+  int batches; /* batches emitted this run */
+  int spawned; /* enemies placed this run */
+  int starved; /* enemies a batch wanted but the pool had no slot for */
+} SpawnDirector;
+
+typedef struct {
+  int merges;      /* XP orbs folded into a nearby orb */
+  int overflows;   /* spawns that found the pool full */
+  int lost;        /* non-XP drops discarded on overflow */
+  float banked_xp; /* XP with no orb to ride on yet; joins the next one */
+} DropStats;
+
 typedef struct {
   int active;
   float x;
@@ -274,11 +441,31 @@ typedef struct {
   float radial_speed;
   float angle_speed;
   float damage;
-  int scythe_id;
+  HitSet hits;
   int scythe_hit_boss;
   float start_angle;
 } WeaponFX;
 
+#define DEBUFF_TICK_HZ 60
+#define DEBUFF_WHEEL_SLOTS 64
+
+/* Enemies with any effect live in a sparse set and hold one node in a
+   two-level timer wheel, due at their earliest expiry tick. */
+typedef struct {
+  int ready;         /* wheel and set initialised; a zeroed Game resets lazily */
+  float now;         /* seconds of simulated time since the run started */
+  unsigned int tick; /* last wheel tick processed */
+  int wheel[2][DEBUFF_WHEEL_SLOTS];
+  /* per enemy slot, carved from the pool arena */
+  int *next;
+  int *prev;
+  unsigned int *due;
+  signed char *level; /* -1 = not scheduled */
+  int *active;
+  int *active_pos; /* -1 = not in the active set */
+  int active_count;
+} DebuffSystem;
+
 typedef enum {
   MODE_START,
   MODE_WAVE,
@@ -292,9 +479,12 @@ typedef struct {
   int valid;
   GameMode mode;
   Player player;
-  Enemy enemies[MAX_ENEMIES];
-  Bullet bullets[MAX_BULLETS];
-  Drop drops[MAX_DROPS];
+  Enemy *enemies; /* pool-sized copies, carved alongside the live pools */
+  Bullet *bullets;
+  BulletRing bullet_ring;
+  EnemyBullet *enemy_bullets;
+  int enemy_bullet_count;
+  Drop *drops;
   Puddle puddles[MAX_PUDDLES];
   WeaponFX weapon_fx[MAX_WEAPON_FX];
   Totem totems[MAX_TOTEMS];
@@ -315,17 +505,60 @@ typedef struct {
   int high_roll_used;
   float totem_spawn_timer;
   float totem_freeze_timer;
+  float debuff_now;
 } WaveSnapshot;
 
+/* Positions at the start of the last sim tick. A frame is drawn alpha of
+   the way from these to the live state, so motion stays smooth when the
+   display runs faster or out of step with the 60 Hz tick. */
+typedef struct {
+  float *enemy_x; /* by slot, carved from the pool arena */
+  float *enemy_y;
+  unsigned int *enemy_gen;
+  float player_x;
+  float player_y;
+  float camera_x;
+  float camera_y;
+  float alpha;
+  int valid;
+  /* live state set aside while a frame draws interpolated positions */
+  float *live_x;
+  float *live_y;
+  float live_player_x;
+  float live_player_y;
+  float live_camera_x;
+  float live_camera_y;
+  int applied;
+} RenderInterp;
+
+typedef struct {
+  unsigned int hash; /* FNV-1a of the id, compared before strcmp */
+  int index;         /* def index, -1 = empty */
+} IdSlot;
+
+/* Open-addressed id -> def index map, rebuilt whenever a section loads. */
+typedef struct {
+  IdSlot *slots;
+  int cap; /* power of two, at least twice the def count */
+} IdIndex;
+
+/* Def arrays are heap-allocated and sized from the data; db_free releases them. */
 typedef struct {
-  WeaponDef weapons[MAX_WEAPONS];
+  WeaponDef *weapons;
   int weapon_count;
-  ItemDef items[MAX_ITEMS];
+  ItemDef *items;
   int item_count;
-  EnemyDef enemies[MAX_ITEMS];
+  EnemyDef *enemies;
   int enemy_count;
-  CharacterDef characters[MAX_CHARACTERS];
+  CharacterDef *characters;
   int character_count;
+  IdIndex weapon_ids;
+  IdIndex item_ids;
+  IdIndex enemy_ids;
+  IdIndex character_ids;
+  int enemy_eye;   /* well-known defs resolved at load, -1 if absent */
+  int enemy_ghost;
+  int from_pack;
 } Database;
 
 #endif
@@ -0,0 +1,28 @@
+#ifndef BUH_DATA_DATA_PACK_H
+#define BUH_DATA_DATA_PACK_H
+
+#include <stdint.h>
+
+#include "core/types.h"
+
+#define DATA_PACK_PATH "data/content.pack"
+#define DATA_PACK_MAGIC 0x50485542u /* "BUHP" */
+#define DATA_PACK_VERSION 1u
+#define DATA_PACK_SECTIONS 4
+
+/* Sections are raw Database arrays (weapons, items, enemies, characters) in
+   that order. def_size guards against struct layout changes; source_hash
+   lets development builds notice edited JSON and fall back to it. */
+typedef struct {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t def_size[DATA_PACK_SECTIONS];
+  uint32_t count[DATA_PACK_SECTIONS];
+  uint32_t offset[DATA_PACK_SECTIONS];
+  uint64_t source_hash[DATA_PACK_SECTIONS];
+} DataPackHeader;
+
+int db_write_pack(const Database *db, const char *path);
+int db_load_pack(Database *db, const char *path, int check_sources);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef BUH_DATA_HOT_RELOAD_H
+#define BUH_DATA_HOT_RELOAD_H
+
+#include "core/game.h"
+
+#define HOT_RELOAD_FILES 4
+
+/* Watches data/ for edits to the content JSON and swaps a re-parsed Database
+   into the running game between simulation ticks. */
+typedef struct {
+  int active;
+  void *change_handle; /* Windows change notification */
+  int inotify_fd;      /* Linux */
+  int pending;
+  Uint32 pending_since;
+  Uint32 last_poll;
+  long long mtime[HOT_RELOAD_FILES];
+  long long size[HOT_RELOAD_FILES];
+  int reloads;
+} HotReload;
+
+int hot_reload_init(HotReload *hr);
+int hot_reload_poll(HotReload *hr, Game *g);
+void hot_reload_close(HotReload *hr);
+int game_swap_database(Game *g, Database *next);
+
+#endif
@@ -3,7 +3,32 @@
 
 #include "core/types.h"
 
+#define DATA_WEAPONS_PATH "data/weapons.json"
+#define DATA_ITEMS_PATH "data/items.json"
+#define DATA_ENEMIES_PATH "data/enemies.json"
+#define DATA_CHARACTERS_PATH "data/characters.json"
+#define DATA_ASSETS_PATH "data/assets.json"
+#define DATA_SPAWN_CURVE_PATH "data/spawn_curve.json"
+
+/* One texture entry from data/assets.json. */
+typedef struct {
+  char id[48];
+  char path[160];
+  int preload;
+  int fallback;
+} AssetManifestEntry;
+
 int db_load(Database *db);
+int db_load_json(Database *db);
+int db_load_json_file(Database *db, const char *path);
+void db_build_index(Database *db);
+int db_copy(Database *dst, const Database *src);
+void db_free(Database *db);
 int find_weapon(Database *db, const char *id);
+int find_item(Database *db, const char *id);
+int find_enemy(Database *db, const char *id);
+int find_character(Database *db, const char *id);
+int load_asset_manifest(const char *path, AssetManifestEntry *out, int max, int *count);
+int load_spawn_curve(const char *path, SpawnPhase *out, int max, int *count);
 
 #endif
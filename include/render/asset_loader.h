@@ -0,0 +1,29 @@
+#ifndef BUH_RENDER_ASSET_LOADER_H
+#define BUH_RENDER_ASSET_LOADER_H
+
+#include <SDL.h>
+
+/* One image to decode; out receives the uploaded texture (NULL on failure). */
+typedef struct {
+  char path[160];
+  SDL_Texture **out;
+  int fallback; /* also try ../ and ../../ like load_texture_fallback */
+  SDL_Surface *surface;
+  SDL_atomic_t done;
+  double decode_ms;
+  char error[128];
+} AssetRequest;
+
+typedef struct {
+  AssetRequest *items;
+  int count;
+  int cap;
+  SDL_atomic_t next; /* next request a worker should claim */
+} AssetBatch;
+
+void asset_batch_init(AssetBatch *b);
+void asset_batch_add(AssetBatch *b, const char *path, SDL_Texture **out, int fallback);
+int asset_batch_load(AssetBatch *b, SDL_Renderer *r);
+void asset_batch_free(AssetBatch *b);
+
+#endif
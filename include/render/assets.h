@@ -0,0 +1,39 @@
+#ifndef BUH_RENDER_ASSETS_H
+#define BUH_RENDER_ASSETS_H
+
+#include <SDL.h>
+
+#include "core/config.h"
+
+/* Index into AssetRegistry.entries; ASSET_NONE when unresolved. */
+typedef int AssetHandle;
+#define ASSET_NONE (-1)
+
+typedef struct {
+  char id[48];
+  char path[160];
+  int fallback; /* also try ../ and ../../ like load_texture_fallback */
+  int preload;  /* decoded at startup and never unloaded */
+  int refcount;
+  int failed;   /* load attempted and failed; don't retry every frame */
+  SDL_Texture *tex;
+} AssetEntry;
+
+typedef struct {
+  AssetEntry entries[MAX_ASSETS];
+  int count;
+  SDL_Renderer *renderer;
+} AssetRegistry;
+
+void assets_init(AssetRegistry *a, SDL_Renderer *r);
+AssetHandle assets_register(AssetRegistry *a, const char *id, const char *path, int preload, int fallback);
+AssetHandle assets_find(const AssetRegistry *a, const char *id);
+SDL_Texture *assets_get(AssetRegistry *a, AssetHandle h);
+void assets_acquire(AssetRegistry *a, AssetHandle h);
+void assets_release(AssetRegistry *a, AssetHandle h);
+int assets_prefetch(AssetRegistry *a);
+int assets_unload_unused(AssetRegistry *a);
+int assets_loaded_count(const AssetRegistry *a);
+void assets_free(AssetRegistry *a);
+
+#endif
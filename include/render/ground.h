@@ -0,0 +1,27 @@
+#ifndef BUH_RENDER_GROUND_H
+#define BUH_RENDER_GROUND_H
+
+#include <SDL.h>
+
+/* Arena floor: ground variants and decals are packed into two atlases and
+   each layer is submitted as a single SDL_RenderGeometry batch per frame. */
+typedef struct {
+  SDL_Texture *atlas;       /* variants side by side, tile_size each */
+  SDL_Texture *decal_atlas; /* decals side by side, decal_size each */
+  int tile_size;
+  int variant_count;
+  int decal_size;
+  int decal_count;
+  SDL_Vertex *verts;        /* scratch, grown when the view gets larger */
+  int *indices;
+  int quad_cap;
+} GroundLayer;
+
+int ground_load(GroundLayer *gl, SDL_Renderer *r);
+void ground_free(GroundLayer *gl);
+int ground_variant_at(const GroundLayer *gl, int tx, int ty);
+int ground_decal_at(const GroundLayer *gl, int tx, int ty);
+void ground_draw(GroundLayer *gl, SDL_Renderer *r, int cam_x, int cam_y, int offset_x, int offset_y,
+                 int view_w, int view_h);
+
+#endif
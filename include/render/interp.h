@@ -0,0 +1,14 @@
+#ifndef BUH_RENDER_INTERP_H
+#define BUH_RENDER_INTERP_H
+
+#include "core/game.h"
+
+/* Records the state at the start of a sim tick. */
+void interp_capture(Game *g);
+/* Fraction of a tick the display is ahead of the last captured state. */
+void interp_set_alpha(Game *g, float alpha);
+/* Swaps blended positions into g for drawing; interp_end puts the live ones back. */
+void interp_begin(Game *g);
+void interp_end(Game *g);
+
+#endif
@@ -14,6 +14,7 @@ void draw_text(SDL_Renderer *r, TTF_Font *font, int x, int y, SDL_Color color, c
 void draw_text_centered(SDL_Renderer *r, TTF_Font *font, int cx, int y, SDL_Color color, const char *text);
 void draw_text_centered_outline(SDL_Renderer *r, TTF_Font *font, int cx, int y, SDL_Color text, SDL_Color outline, int thickness, const char *msg);
 void draw_sword_orbit(Game *g, int offset_x, int offset_y, float cam_x, float cam_y);
+void draw_profiler_overlay(Game *g);
 
 void render_game(Game *g);
 
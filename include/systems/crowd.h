@@ -0,0 +1,8 @@
+#ifndef BUH_SYSTEMS_CROWD_H
+#define BUH_SYSTEMS_CROWD_H
+
+#include "core/game.h"
+
+void crowd_separate(Game *g, float dt);
+
+#endif
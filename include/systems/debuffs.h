@@ -0,0 +1,19 @@
+#ifndef BUH_SYSTEMS_DEBUFFS_H
+#define BUH_SYSTEMS_DEBUFFS_H
+
+#include "core/game.h"
+
+void debuffs_reset(Game *g);
+void debuffs_rebuild(Game *g);
+void debuffs_update(Game *g, float dt);
+void debuffs_clear(Game *g, int enemy);
+void debuff_apply(Game *g, Enemy *en, DebuffKind kind, float duration);
+void debuff_extend(Game *g, Enemy *en, DebuffKind kind, float duration);
+void debuff_add_bleed(Game *g, Enemy *en, float duration);
+float debuff_remaining(const Game *g, const Enemy *en, DebuffKind kind);
+
+static inline int debuff_active(const Game *g, const Enemy *en, DebuffKind kind) {
+  return en->debuffs.until[kind] > g->debuffs.now;
+}
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef BUH_SYSTEMS_DIRECTOR_H
+#define BUH_SYSTEMS_DIRECTOR_H
+
+#include "core/game.h"
+
+void director_reset(Game *g);
+int director_sample(const SpawnDirector *d, float t, float *interval, int *batch);
+int spawn_enemy_batch(Game *g, const int *defs, int def_count, SpawnPattern pattern, int count);
+void director_update(Game *g, float dt);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef BUH_SYSTEMS_DROPS_H
+#define BUH_SYSTEMS_DROPS_H
+
+#include "core/game.h"
+
+void drops_clear(Game *g);
+int drops_spawn_xp(Game *g, float x, float y, float value);
+void drops_magnet_step(Game *g, float px, float py, float dt);
+
+/* Merged orbs grow with the square root of what they carry. */
+static inline float drop_xp_scale(float value) {
+  return clampf(sqrtf(value / DROP_XP_BASE_VALUE), 1.0f, DROP_XP_MAX_SCALE);
+}
+
+#endif
@@ -4,6 +4,8 @@
 #include "core/game.h"
 
 const char *enemy_label(Game *g, Enemy *e);
+int enemy_alloc_batch(Game *g, int *out, int n);
+void enemy_init(Game *g, int slot, int def_index, float x, float y);
 void spawn_enemy(Game *g, int def_index);
 void update_enemies(Game *g, float dt);
 
@@ -0,0 +1,11 @@
+#ifndef BUH_SYSTEMS_FIELD_H
+#define BUH_SYSTEMS_FIELD_H
+
+#include "core/game.h"
+
+int damage_field_build(Game *g);
+void damage_field_apply(Game *g, float dt);
+int damage_field_reserve(DamageField *f);
+void damage_field_free(DamageField *f);
+
+#endif
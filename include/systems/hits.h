@@ -0,0 +1,12 @@
+#ifndef BUH_SYSTEMS_HITS_H
+#define BUH_SYSTEMS_HITS_H
+
+#include "core/game.h"
+
+void hit_sets_reset(Game *g);
+void hit_sets_forget_enemy(Game *g, int enemy);
+void hit_set_clear(Game *g, HitSet *s);
+int hit_set_contains(const Game *g, const HitSet *s, int enemy);
+int hit_set_add(Game *g, HitSet *s, int enemy);
+
+#endif
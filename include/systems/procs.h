@@ -0,0 +1,10 @@
+#ifndef BUH_SYSTEMS_PROCS_H
+#define BUH_SYSTEMS_PROCS_H
+
+#include "core/game.h"
+
+void procs_queue_chain(Game *g, int start, float damage, int bounces, float range);
+void procs_flush(Game *g);
+void procs_clear(Game *g);
+
+#endif
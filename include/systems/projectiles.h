@@ -0,0 +1,17 @@
+#ifndef BUH_SYSTEMS_PROJECTILES_H
+#define BUH_SYSTEMS_PROJECTILES_H
+
+#include "core/game.h"
+
+
+int bullet_ring_alloc(Game *g);
+void bullet_ring_retire(Game *g);
+void bullet_ring_integrate(BulletRing *r, float dt);
+void bullet_ring_copy(BulletRing *dst, const BulletRing *src);
+void bullets_clear(Game *g);
+
+static inline int bullet_ring_count(const BulletRing *r) {
+  return (int)(r->tail - r->head);
+}
+
+#endif
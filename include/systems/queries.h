@@ -0,0 +1,61 @@
+#ifndef BUH_SYSTEMS_QUERIES_H
+#define BUH_SYSTEMS_QUERIES_H
+
+#include "core/game.h"
+
+/* Point-in-shape tests. Direction and axis vectors are unit length. */
+
+/* Cone from (ox, oy) along (dx, dy) out to range, cos_half = cos of the half angle. */
+static inline int geom_in_sector(float px, float py, float ox, float oy, float dx, float dy, float range,
+                                 float cos_half) {
+  float ex = px - ox;
+  float ey = py - oy;
+  float d2 = ex * ex + ey * ey;
+  if (d2 > range * range) return 0;
+  float len = sqrtf(d2);
+  if (len < 0.001f) len = 0.001f;
+  return (ex * dx + ey * dy) / len >= cos_half;
+}
+
+/* Box centered on (cx, cy): half_len along (ux, uy), half_w across it. */
+static inline int geom_in_obb(float px, float py, float cx, float cy, float ux, float uy, float half_len,
+                              float half_w) {
+  float ex = px - cx;
+  float ey = py - cy;
+  return fabsf(ex * ux + ey * uy) <= half_len && fabsf(ey * ux - ex * uy) <= half_w;
+}
+
+/* Points within radius of the segment (x0, y0)-(x1, y1). */
+static inline int geom_in_capsule(float px, float py, float x0, float y0, float x1, float y1, float radius) {
+  float sx = x1 - x0;
+  float sy = y1 - y0;
+  float ex = px - x0;
+  float ey = py - y0;
+  float len2 = sx * sx + sy * sy;
+  float t = len2 > 0.0f ? (ex * sx + ey * sy) / len2 : 0.0f;
+  if (t < 0.0f) t = 0.0f;
+  if (t > 1.0f) t = 1.0f;
+  float qx = ex - sx * t;
+  float qy = ey - sy * t;
+  return qx * qx + qy * qy <= radius * radius;
+}
+
+/* Annulus r_inner <= d <= r_outer; r_inner = 0 gives a disk. */
+static inline int geom_in_ring(float px, float py, float cx, float cy, float r_inner, float r_outer) {
+  float ex = px - cx;
+  float ey = py - cy;
+  float d2 = ex * ex + ey * ey;
+  return d2 <= r_outer * r_outer && d2 >= r_inner * r_inner;
+}
+
+/* Active enemies whose centers fall inside the shape. Only grid cells the
+   shape's bounds overlap are visited. Results are written to out in cell
+   order; the return value is the count, at most max_out. */
+int enemy_query_sector(const Game *g, float ox, float oy, float dx, float dy, float range, float cos_half, int *out,
+                       int max_out);
+int enemy_query_obb(const Game *g, float cx, float cy, float ux, float uy, float half_len, float half_w, int *out,
+                    int max_out);
+int enemy_query_capsule(const Game *g, float x0, float y0, float x1, float y1, float radius, int *out, int max_out);
+int enemy_query_ring(const Game *g, float cx, float cy, float r_inner, float r_outer, int *out, int max_out);
+
+#endif
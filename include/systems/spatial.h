@@ -0,0 +1,13 @@
+#ifndef BUH_SYSTEMS_SPATIAL_H
+#define BUH_SYSTEMS_SPATIAL_H
+
+#include "core/game.h"
+
+void enemy_grid_build(Game *g);
+int segment_circle_hit(float x0, float y0, float x1, float y1, float cx, float cy, float r, float *out_t);
+int enemy_grid_sweep(const Game *g, float x0, float y0, float x1, float y1, float radius, SweepHit *out, int max_hits);
+int enemy_grid_nearest(const Game *g, float x, float y, float max_dist);
+int enemy_grid_nearest_unmarked(const Game *g, float x, float y, float max_dist, const unsigned int *marks,
+                                unsigned int stamp);
+
+#endif
@@ -0,0 +1,9 @@
+#ifndef BUH_SYSTEMS_TARGETING_H
+#define BUH_SYSTEMS_TARGETING_H
+
+#include "core/game.h"
+
+void targeting_update(Game *g);
+int targeting_random_onscreen(const Game *g);
+
+#endif
@@ -0,0 +1,26 @@
+#include "core/arena.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+int arena_init(Arena *a, size_t size) {
+  a->base = (unsigned char *)malloc(size > 0 ? size : 1);
+  a->size = a->base ? size : 0;
+  a->used = 0;
+  return a->base != NULL;
+}
+
+/* Zeroed, ARENA_ALIGN-aligned memory; NULL when measuring or out of room. */
+void *arena_alloc(Arena *a, size_t size) {
+  size_t at = (a->used + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1);
+  if (a->base && at + size > a->size) return NULL;
+  a->used = at + size;
+  if (!a->base) return NULL;
+  memset(a->base + at, 0, size);
+  return a->base + at;
+}
+
+void arena_free(Arena *a) {
+  free(a->base);
+  memset(a, 0, sizeof(*a));
+}
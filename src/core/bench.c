@@ -0,0 +1,135 @@
+#include "core/bench.h"
+
+#include "core/profiler.h"
+#include "data/registry.h"
+#include "systems/director.h"
+#include "systems/enemies.h"
+#include "systems/weapons.h"
+
+/* Headless run: `buh --bench [ticks=N] [enemies=N] [seed=N] [crowd=0|1] [--hw]`; pool sizes
+   come from --profile like a normal run.
+   Returns 1 when --bench is present. */
+int bench_parse_args(BenchOptions *o, int argc, char **argv) {
+  int found = 0;
+  o->ticks = 3600;
+  o->enemies = 1000;
+  o->hw_counters = 0;
+  o->crowd = 1;
+  o->seed = 1234u;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--bench") == 0) found = 1;
+    else if (strcmp(argv[i], "--hw") == 0) o->hw_counters = 1;
+    else if (strncmp(argv[i], "ticks=", 6) == 0) o->ticks = atoi(argv[i] + 6);
+    else if (strncmp(argv[i], "enemies=", 8) == 0) o->enemies = atoi(argv[i] + 8);
+    else if (strncmp(argv[i], "seed=", 5) == 0) o->seed = (unsigned int)strtoul(argv[i] + 5, NULL, 10);
+    else if (strncmp(argv[i], "crowd=", 6) == 0) o->crowd = atoi(argv[i] + 6) != 0;
+  }
+  if (o->ticks < 1) o->ticks = 1;
+  if (o->enemies < 0) o->enemies = 0;
+  return found;
+}
+
+static void bench_out(const char *fmt, ...) {
+  char buf[512];
+  va_list args;
+  va_start(args, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+  printf("%s\n", buf);
+  log_line(buf);
+}
+
+static int count_active_enemies(Game *g) {
+  int n = 0;
+  for (int i = 0; i < g->caps.enemies; i++) n += g->enemies[i].active;
+  return n;
+}
+
+/* Starts a run as the first character with every weapon slot filled, then
+   keeps the horde topped up and the player alive for a fixed number of ticks.
+   The run is headless: a death inside a tick never touches saved progress. */
+int run_benchmark(Game *g, const BenchOptions *o) {
+  const float dt = 1.0f / 60.0f;
+  srand(o->seed);
+  game_reset(g);
+  g->headless = 1;
+  if (g->db.character_count > 0) {
+    CharacterDef *c = &g->db.characters[0];
+    g->selected_character = 0;
+    stats_add(&g->player.base, &c->stats);
+    int widx = find_weapon(&g->db, c->weapon);
+    if (widx >= 0) equip_weapon(&g->player, widx);
+  }
+  for (int i = 0; i < g->db.weapon_count; i++) {
+    if (weapon_choice_allowed(g, i) && !weapon_is_owned(&g->player, i, NULL)) equip_weapon(&g->player, i);
+  }
+  wave_start(g);
+  g->crowd_disabled = !o->crowd;
+
+  prof_init();
+  int hw_mask = 0;
+  if (o->hw_counters) {
+    hw_mask = prof_hw_enable();
+    if (!hw_mask) bench_out("bench: hardware counters unavailable (perf_event_paranoid or platform)");
+  }
+
+  double entity_ticks = 0.0;
+  double lod_ticks[ENEMY_LOD_BUCKETS] = {0.0};
+  double lod_updates = 0.0;
+  double crowd_neighbors = 0.0;
+  double crowd_pushed = 0.0;
+  Uint64 t0 = SDL_GetPerformanceCounter();
+  for (int t = 0; t < o->ticks; t++) {
+    int active = count_active_enemies(g);
+    while (active < o->enemies) {
+      int got = spawn_enemy_batch(g, NULL, 0, SPAWN_EDGE, o->enemies - active);
+      if (got == 0) break;
+      active += got;
+    }
+    entity_ticks += (double)count_active_enemies(g);
+
+    Stats stats = player_total_stats(&g->player, &g->db);
+    g->player.hp = stats.max_hp;
+    g->mode = MODE_WAVE;
+    prof_begin(PROF_SIM_TICK);
+    update_game(g, dt);
+    prof_end(PROF_SIM_TICK);
+    prof_frame_end();
+    for (int b = 0; b < ENEMY_LOD_BUCKETS; b++) lod_ticks[b] += (double)g->enemy_lod_counts[b];
+    lod_updates += (double)g->enemy_lod_updates;
+    crowd_neighbors += (double)g->crowd_neighbors;
+    crowd_pushed += (double)g->crowd_pushed;
+  }
+  double wall_ms = (double)(SDL_GetPerformanceCounter() - t0) * g_prof.ms_per_count;
+  if (o->hw_counters) prof_hw_disable();
+
+  bench_out("bench: %d ticks, target %d enemies (pool %d, avg %.1f active), seed %u, %.1f ms wall, %.1f ticks/s",
+            o->ticks, o->enemies, g->caps.enemies, entity_ticks / (double)o->ticks, o->seed, wall_ms,
+            wall_ms > 0.0 ? (double)o->ticks * 1000.0 / wall_ms : 0.0);
+  bench_out("  enemy lod avg %.1f/%.1f/%.1f/%.1f per bucket, %.1f full updates/tick", lod_ticks[0] / o->ticks,
+            lod_ticks[1] / o->ticks, lod_ticks[2] / o->ticks, lod_ticks[3] / o->ticks, lod_updates / o->ticks);
+  bench_out("  crowd separation %s, %.1f pushes/tick, %.2f neighbours per push", o->crowd ? "on" : "off",
+            crowd_pushed / o->ticks, crowd_pushed > 0.0 ? crowd_neighbors / crowd_pushed : 0.0);
+  for (int z = 0; z < PROF_RENDER_WORLD; z++) {
+    if (g_prof.zone_calls[z] == 0) continue;
+    double total_ms = (double)g_prof.zone_total[z] * g_prof.ms_per_count;
+    char hw[256] = "";
+    if (hw_mask) {
+      const Uint64 *h = g_prof.hw_total[z];
+      size_t len = (size_t)snprintf(hw, sizeof(hw), "  %s=%llu", hw_counter_name(HW_CYCLES),
+                                    (unsigned long long)h[HW_CYCLES]);
+      if ((hw_mask & (1 << HW_INSTRUCTIONS)) && h[HW_CYCLES] > 0 && len < sizeof(hw)) {
+        len += (size_t)snprintf(hw + len, sizeof(hw) - len, " ipc=%.2f", (double)h[HW_INSTRUCTIONS] / (double)h[HW_CYCLES]);
+      }
+      if ((hw_mask & (1 << HW_CACHE_MISSES)) && entity_ticks > 0.0 && len < sizeof(hw)) {
+        len += (size_t)snprintf(hw + len, sizeof(hw) - len, " cache_miss/ent=%.2f", (double)h[HW_CACHE_MISSES] / entity_ticks);
+      }
+      if ((hw_mask & (1 << HW_BRANCH_MISSES)) && entity_ticks > 0.0 && len < sizeof(hw)) {
+        snprintf(hw + len, sizeof(hw) - len, " branch_miss/ent=%.2f", (double)h[HW_BRANCH_MISSES] / entity_ticks);
+      }
+    }
+    bench_out("  %-16s %8.2f ms total %8.1f us/tick%s", prof_zone_name((ProfZone)z), total_ms,
+              total_ms * 1000.0 / (double)o->ticks, hw);
+  }
+  return 1;
+}
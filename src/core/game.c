@@ -1,11 +1,23 @@
 
 #include "core/game.h"
+#include "core/profiler.h"
 #include "data/registry.h"
+#include "render/interp.h"
 #include "render/render.h"
+#include "systems/crowd.h"
+#include "systems/debuffs.h"
+#include "systems/director.h"
+#include "systems/drops.h"
 #include "systems/enemies.h"
+#include "systems/hits.h"
+#include "systems/procs.h"
+#include "systems/projectiles.h"
+#include "systems/queries.h"
 #include "systems/weapons.h"
 #include "systems/skill_tree.h"
 
+#include <assert.h>
+
 FILE *g_log = NULL;
 int g_log_combat = 1;
 FILE *g_combat_log = NULL;
@@ -45,6 +57,129 @@ SDL_Texture *load_texture_fallback(SDL_Renderer *r, const char *path)
   return IMG_LoadTexture(r, alt);
 }
 
+static const char *k_texture_ids[TEX_COUNT] = {
+    "health_flask", "enemy_goo", "enemy_eye", "enemy_ghost", "enemy_charger", "boss_fire_goo",
+    "player_front", "player_back", "player_right", "player_left", "enemy_bolt", "lightning_zone",
+    "chest", "laser_beam", "scythe", "vampire_bite", "dagger", "alchemist_puddle",
+    "fire_trail", "alchemist_ult", "exp_orb", "orb_common", "orb_uncommon", "orb_rare",
+    "orb_epic", "orb_legendary", "totem_freeze", "totem_curse", "totem_damage",
+};
+
+const char *game_tex_id(TextureId id)
+{
+  if (id < 0 || id >= TEX_COUNT)
+    return "";
+  return k_texture_ids[id];
+}
+
+/* Per-character entries are keyed by character id, so rebinding after the
+   character list changes keeps existing handles and refcounts. */
+void game_assets_bind_characters(Game *g)
+{
+  for (int i = 0; i < MAX_CHARACTERS; i++)
+  {
+    g->tex_walk[i] = ASSET_NONE;
+    g->tex_portrait[i] = ASSET_NONE;
+  }
+  for (int i = 0; i < g->db.character_count && i < MAX_CHARACTERS; i++)
+  {
+    CharacterDef *c = &g->db.characters[i];
+    char id[64];
+    char path[160];
+    if (c->walk_strip[0])
+    {
+      snprintf(id, sizeof(id), "walk/%s", c->id);
+      snprintf(path, sizeof(path), "data/assets/%s", c->walk_strip);
+      g->tex_walk[i] = assets_register(&g->assets, id, path, 0, 0);
+    }
+    if (c->portrait[0])
+    {
+      snprintf(id, sizeof(id), "portrait/%s", c->id);
+      snprintf(path, sizeof(path), "data/assets/portraits/%s", c->portrait);
+      g->tex_portrait[i] = assets_register(&g->assets, id, path, 0, 0);
+    }
+  }
+}
+
+/* Registers data/assets.json plus a walk strip and portrait per character, then
+   resolves every TextureId slot. Returns 0 if the manifest could not be read. */
+int game_assets_init(Game *g, SDL_Renderer *r)
+{
+  assets_init(&g->assets, r);
+  static AssetManifestEntry manifest[MAX_ASSETS];
+  int count = 0;
+  int ok = load_asset_manifest(DATA_ASSETS_PATH, manifest, MAX_ASSETS, &count);
+  if (!ok)
+    log_linef("Failed to read %s", DATA_ASSETS_PATH);
+  for (int i = 0; i < count; i++)
+    assets_register(&g->assets, manifest[i].id, manifest[i].path, manifest[i].preload, manifest[i].fallback);
+  for (int i = 0; i < TEX_COUNT; i++)
+  {
+    g->tex[i] = assets_find(&g->assets, k_texture_ids[i]);
+    if (g->tex[i] == ASSET_NONE)
+      log_linef("Asset manifest has no entry for %s", k_texture_ids[i]);
+  }
+  game_assets_bind_characters(g);
+  g->run_walk = ASSET_NONE;
+  g->menu_assets_held = 0;
+  log_linef("Asset registry: %d entries (%d from manifest)", g->assets.count, count);
+  return ok;
+}
+
+SDL_Texture *game_tex(Game *g, TextureId id)
+{
+  if (id < 0 || id >= TEX_COUNT)
+    return NULL;
+  return assets_get(&g->assets, g->tex[id]);
+}
+
+SDL_Texture *game_walk_tex(Game *g, int char_idx)
+{
+  if (char_idx < 0 || char_idx >= MAX_CHARACTERS)
+    return NULL;
+  return assets_get(&g->assets, g->tex_walk[char_idx]);
+}
+
+SDL_Texture *game_portrait_tex(Game *g, int char_idx)
+{
+  if (char_idx < 0 || char_idx >= MAX_CHARACTERS)
+    return NULL;
+  return assets_get(&g->assets, g->tex_portrait[char_idx]);
+}
+
+/* Character select needs every portrait; nothing run-specific stays held. */
+void game_assets_enter_menu(Game *g)
+{
+  if (!g->menu_assets_held)
+  {
+    for (int i = 0; i < g->db.character_count && i < MAX_CHARACTERS; i++)
+      assets_acquire(&g->assets, g->tex_portrait[i]);
+    g->menu_assets_held = 1;
+  }
+  if (g->run_walk != ASSET_NONE)
+  {
+    assets_release(&g->assets, g->run_walk);
+    g->run_walk = ASSET_NONE;
+  }
+}
+
+/* Swaps the menu set for the chosen hero's strip and drops everything unheld. */
+void game_assets_enter_run(Game *g)
+{
+  if (g->menu_assets_held)
+  {
+    for (int i = 0; i < g->db.character_count && i < MAX_CHARACTERS; i++)
+      assets_release(&g->assets, g->tex_portrait[i]);
+    g->menu_assets_held = 0;
+  }
+  if (g->run_walk == ASSET_NONE && g->selected_character >= 0 && g->selected_character < MAX_CHARACTERS)
+  {
+    g->run_walk = g->tex_walk[g->selected_character];
+    assets_acquire(&g->assets, g->run_walk);
+  }
+  assets_unload_unused(&g->assets);
+}
+
 LONG WINAPI crash_handler(EXCEPTION_POINTERS *e)
 {
   log_linef("Crash code: 0x%08lx", (unsigned long)e->ExceptionRecord->ExceptionCode);
@@ -118,9 +253,12 @@ static void wave_snapshot_save(Game *g)
   g->wave_snapshot.valid = 1;
   g->wave_snapshot.mode = g->mode;
   g->wave_snapshot.player = g->player;
-  memcpy(g->wave_snapshot.enemies, g->enemies, sizeof(g->enemies));
-  memcpy(g->wave_snapshot.bullets, g->bullets, sizeof(g->bullets));
-  memcpy(g->wave_snapshot.drops, g->drops, sizeof(g->drops));
+  memcpy(g->wave_snapshot.enemies, g->enemies, sizeof(*g->enemies) * (size_t)g->caps.enemies);
+  memcpy(g->wave_snapshot.bullets, g->bullets, sizeof(*g->bullets) * (size_t)g->caps.bullets);
+  bullet_ring_copy(&g->wave_snapshot.bullet_ring, &g->bullet_ring);
+  memcpy(g->wave_snapshot.enemy_bullets, g->enemy_bullets, sizeof(*g->enemy_bullets) * (size_t)g->caps.enemy_bullets);
+  g->wave_snapshot.enemy_bullet_count = g->enemy_bullet_count;
+  memcpy(g->wave_snapshot.drops, g->drops, sizeof(*g->drops) * (size_t)g->caps.drops);
   memcpy(g->wave_snapshot.puddles, g->puddles, sizeof(g->puddles));
   memcpy(g->wave_snapshot.weapon_fx, g->weapon_fx, sizeof(g->weapon_fx));
   memcpy(g->wave_snapshot.totems, g->totems, sizeof(g->totems));
@@ -141,6 +279,7 @@ static void wave_snapshot_save(Game *g)
   g->wave_snapshot.high_roll_used = g->high_roll_used;
   g->wave_snapshot.totem_spawn_timer = g->totem_spawn_timer;
   g->wave_snapshot.totem_freeze_timer = g->totem_freeze_timer;
+  g->wave_snapshot.debuff_now = g->debuffs.now;
 }
 
 static void wave_snapshot_restore(Game *g)
@@ -149,12 +288,16 @@ static void wave_snapshot_restore(Game *g)
     return;
   g->mode = g->wave_snapshot.mode;
   g->player = g->wave_snapshot.player;
-  memcpy(g->enemies, g->wave_snapshot.enemies, sizeof(g->enemies));
-  memcpy(g->bullets, g->wave_snapshot.bullets, sizeof(g->bullets));
-  memcpy(g->drops, g->wave_snapshot.drops, sizeof(g->drops));
+  memcpy(g->enemies, g->wave_snapshot.enemies, sizeof(*g->enemies) * (size_t)g->caps.enemies);
+  memcpy(g->bullets, g->wave_snapshot.bullets, sizeof(*g->bullets) * (size_t)g->caps.bullets);
+  bullet_ring_copy(&g->bullet_ring, &g->wave_snapshot.bullet_ring);
+  memcpy(g->enemy_bullets, g->wave_snapshot.enemy_bullets, sizeof(*g->enemy_bullets) * (size_t)g->caps.enemy_bullets);
+  g->enemy_bullet_count = g->wave_snapshot.enemy_bullet_count;
+  memcpy(g->drops, g->wave_snapshot.drops, sizeof(*g->drops) * (size_t)g->caps.drops);
   memcpy(g->puddles, g->wave_snapshot.puddles, sizeof(g->puddles));
   memcpy(g->weapon_fx, g->wave_snapshot.weapon_fx, sizeof(g->weapon_fx));
   memcpy(g->totems, g->wave_snapshot.totems, sizeof(g->totems));
+  hit_sets_reset(g);
   g->spawn_timer = g->wave_snapshot.spawn_timer;
   g->kills = g->wave_snapshot.kills;
   g->xp = g->wave_snapshot.xp;
@@ -172,13 +315,15 @@ static void wave_snapshot_restore(Game *g)
   g->high_roll_used = g->wave_snapshot.high_roll_used;
   g->totem_spawn_timer = g->wave_snapshot.totem_spawn_timer;
   g->totem_freeze_timer = g->wave_snapshot.totem_freeze_timer;
+  g->debuffs.now = g->wave_snapshot.debuff_now;
+  debuffs_rebuild(g);
 }
 
 static int find_nearest_enemy(Game *g, float x, float y)
 {
   float best = 999999.0f;
   int idx = -1;
-  for (int i = 0; i < MAX_ENEMIES; i++)
+  for (int i = 0; i < g->caps.enemies; i++)
   {
     if (!g->enemies[i].active)
       continue;
@@ -314,17 +459,6 @@ void stats_scale(Stats *s, float mul)
   s->hp_regen *= mul;
 }
 
-static int find_enemy_def(Database *db, const char *id)
-{
-  if (!db || !id)
-    return -1;
-  for (int i = 0; i < db->enemy_count; i++)
-  {
-    if (strcmp(db->enemies[i].id, id) == 0)
-      return i;
-  }
-  return -1;
-}
 
 static WeaponSlot *find_weapon_slot(Player *p, Database *db, const char *id)
 {
@@ -615,10 +749,10 @@ void mark_enemy_hit(Enemy *en)
 
 float player_apply_hit_mods(Game *g, Enemy *en, float dmg)
 {
-  if (en->debuffs.armor_shred_timer > 0.0f)
+  if (debuff_active(g, en, DEBUFF_ARMOR_SHRED))
     dmg *= 1.2f;
   float slow_bonus = player_slow_bonus_damage(&g->player, &g->db);
-  if (slow_bonus > 0.0f && en->debuffs.slow_timer > 0.0f)
+  if (slow_bonus > 0.0f && debuff_active(g, en, DEBUFF_SLOW))
   {
     float extra = dmg * slow_bonus;
     log_combatf(g, "slow_bonus +%.1f dmg to %s", extra, enemy_label(g, en));
@@ -627,47 +761,6 @@ float player_apply_hit_mods(Game *g, Enemy *en, float dmg)
   return dmg;
 }
 
-static void proc_chain_lightning(Game *g, int start_idx, float dmg, int bounces, float range)
-{
-  if (bounces <= 0 || range <= 0.0f)
-    return;
-  int visited[MAX_ENEMIES];
-  memset(visited, 0, sizeof(visited));
-  visited[start_idx] = 1;
-  int current = start_idx;
-  float range2 = range * range;
-
-  for (int b = 0; b < bounces; b++)
-  {
-    int next = -1;
-    float best = range2;
-    float cx = g->enemies[current].x;
-    float cy = g->enemies[current].y;
-    for (int i = 0; i < MAX_ENEMIES; i++)
-    {
-      if (!g->enemies[i].active || visited[i])
-        continue;
-      float dx = g->enemies[i].x - cx;
-      float dy = g->enemies[i].y - cy;
-      float d2 = dx * dx + dy * dy;
-      if (d2 < best)
-      {
-        best = d2;
-        next = i;
-      }
-    }
-    if (next < 0)
-      break;
-    Enemy *en = &g->enemies[next];
-    mark_enemy_hit(en);
-    float hit = player_apply_hit_mods(g, en, dmg);
-    en->hp -= hit;
-    log_combatf(g, "chain_lightning hit %s for %.1f", enemy_label(g, en), hit);
-    visited[next] = 1;
-    current = next;
-  }
-}
-
 void player_try_item_proc(Game *g, int enemy_idx, Stats *stats)
 {
   for (int i = 0; i < g->player.passive_count; i++)
@@ -685,7 +778,7 @@ void player_try_item_proc(Game *g, int enemy_idx, Stats *stats)
       float range = (it->proc_range > 0.0f) ? it->proc_range : 140.0f;
       float dmg = it->proc_damage * (1.0f + stats->damage);
       log_combatf(g, "chain_lightning proc dmg %.1f bounces %d", dmg, it->proc_bounces);
-      proc_chain_lightning(g, enemy_idx, dmg, it->proc_bounces, range);
+      procs_queue_chain(g, enemy_idx, dmg, it->proc_bounces, range);
     }
   }
 }
@@ -707,12 +800,13 @@ float player_damage_reduce(Game *g, float dmg)
 
 static void clear_boss_room(Game *g)
 {
-  for (int i = 0; i < MAX_ENEMIES; i++)
+  for (int i = 0; i < g->caps.enemies; i++)
     g->enemies[i].active = 0;
-  for (int i = 0; i < MAX_BULLETS; i++)
-    g->bullets[i].active = 0;
-  for (int i = 0; i < MAX_DROPS; i++)
-    g->drops[i].active = 0;
+  debuffs_reset(g);
+  bullets_clear(g);
+  procs_clear(g);
+  hit_sets_reset(g);
+  drops_clear(g);
   for (int i = 0; i < MAX_PUDDLES; i++)
     g->puddles[i].active = 0;
   for (int i = 0; i < MAX_WEAPON_FX; i++)
@@ -783,8 +877,10 @@ void start_boss_event(Game *g)
 static void build_boss_reward_choices(Game *g)
 {
   g->choice_count = 0;
-  int legendary_indices[MAX_ITEMS];
+  size_t mark = scratch_mark(&g->tick_scratch);
+  int *legendary_indices = SCRATCH_NEW(&g->tick_scratch, int, g->db.item_count > 0 ? g->db.item_count : 1);
   int legendary_count = 0;
+  assert(legendary_indices);
   for (int i = 0; i < g->db.item_count; i++)
   {
     if (strcmp(g->db.items[i].rarity, "legendary") == 0)
@@ -793,7 +889,10 @@ static void build_boss_reward_choices(Game *g)
     }
   }
   if (legendary_count == 0)
+  {
+    scratch_release(&g->tick_scratch, mark);
     return;
+  }
 
   int picks = legendary_count < 3 ? legendary_count : 3;
   for (int i = legendary_count - 1; i > 0; i--)
@@ -807,6 +906,7 @@ static void build_boss_reward_choices(Game *g)
   {
     g->choices[g->choice_count++] = (LevelUpChoice){.type = 0, .index = legendary_indices[i]};
   }
+  scratch_release(&g->tick_scratch, mark);
 }
 
 static void end_boss_event(Game *g, int success)
@@ -860,7 +960,12 @@ static void end_boss_event(Game *g, int success)
 
 void spawn_drop(Game *g, float x, float y, int type, float value)
 {
-  for (int i = 0; i < MAX_DROPS; i++)
+  if (type == 0)
+  {
+    drops_spawn_xp(g, x, y, value);
+    return;
+  }
+  for (int i = 0; i < g->caps.drops; i++)
   {
     if (!g->drops[i].active)
     {
@@ -875,11 +980,13 @@ void spawn_drop(Game *g, float x, float y, int type, float value)
       return;
     }
   }
+  g->drop_stats.overflows++;
+  g->drop_stats.lost++;
 }
 
 void spawn_chest(Game *g, float x, float y)
 {
-  for (int i = 0; i < MAX_DROPS; i++)
+  for (int i = 0; i < g->caps.drops; i++)
   {
     if (!g->drops[i].active)
     {
@@ -1069,7 +1176,7 @@ static void player_recalc(Player *p, Database *db)
 
 void apply_item(Player *p, Database *db, ItemDef *it, int item_index)
 {
-  if (p->passive_count < MAX_ITEMS)
+  if (p->passive_count < MAX_PASSIVE_ITEMS)
   {
     p->passive_items[p->passive_count++] = item_index;
   }
@@ -1200,14 +1307,14 @@ static SDL_Texture *rarity_orb_texture(Game *g, const char *rarity)
   if (!g || !rarity)
     return NULL;
   if (strcmp(rarity, "uncommon") == 0)
-    return g->tex_orb_uncommon;
+    return game_tex(g, TEX_ORB_UNCOMMON);
   if (strcmp(rarity, "rare") == 0)
-    return g->tex_orb_rare;
+    return game_tex(g, TEX_ORB_RARE);
   if (strcmp(rarity, "epic") == 0)
-    return g->tex_orb_epic;
+    return game_tex(g, TEX_ORB_EPIC);
   if (strcmp(rarity, "legendary") == 0)
-    return g->tex_orb_legendary;
-  return g->tex_orb_common;
+    return game_tex(g, TEX_ORB_LEGENDARY);
+  return game_tex(g, TEX_ORB_COMMON);
 }
 
 static int levelup_orb_size(const SDL_Rect *rect)
@@ -1388,6 +1495,7 @@ static int strcasestr_simple(const char *haystack, const char *needle)
 void game_reset(Game *g)
 {
   update_window_view(g);
+  game_assets_enter_menu(g);
   g->spawn_timer = 0.0f;
   g->kills = 0;
   g->xp = 0;
@@ -1397,7 +1505,6 @@ void game_reset(Game *g)
   g->last_item_index = -1;
   g->item_popup_timer = 0.0f;
   g->item_popup_name[0] = '\0';
-  g->scythe_id_counter = 0;
   g->mode = MODE_START;
   g->pause_return_mode = MODE_START;
   g->time_scale = 1.0f;
@@ -1417,12 +1524,13 @@ void game_reset(Game *g)
   g->selected_character = -1;
   g->rerolls = 2;        /* 2 rerolls per run */
   g->high_roll_used = 0; /* high roll available once per run */
-  for (int i = 0; i < MAX_ENEMIES; i++)
+  for (int i = 0; i < g->caps.enemies; i++)
     g->enemies[i].active = 0;
-  for (int i = 0; i < MAX_BULLETS; i++)
-    g->bullets[i].active = 0;
-  for (int i = 0; i < MAX_DROPS; i++)
-    g->drops[i].active = 0;
+  bullets_clear(g);
+  procs_clear(g);
+  hit_sets_reset(g);
+  drops_clear(g);
+  director_reset(g);
   for (int i = 0; i < MAX_PUDDLES; i++)
     g->puddles[i].active = 0;
   for (int i = 0; i < MAX_TOTEMS; i++)
@@ -1472,7 +1580,7 @@ void game_reset(Game *g)
     if (dx * dx + dy * dy < 600.0f * 600.0f)
       continue;
     int too_close = 0;
-    for (int i = 0; i < MAX_DROPS; i++)
+    for (int i = 0; i < g->caps.drops; i++)
     {
       if (!g->drops[i].active)
         continue;
@@ -1507,6 +1615,7 @@ static void level_up(Game *g)
 
 void wave_start(Game *g)
 {
+  game_assets_enter_run(g);
   g->mode = MODE_WAVE;
   g->spawn_timer = 0.0f;
 }
@@ -1520,7 +1629,7 @@ static void handle_player_pickups(Game *g, float dt)
   float health_pickup_range = 30.0f;                /* health pickup distance */
   float chest_pickup_range = 26.0f;
 
-  for (int i = 0; i < MAX_DROPS; i++)
+  for (int i = 0; i < g->caps.drops; i++)
   {
     Drop *d = &g->drops[i];
     if (!d->active)
@@ -1528,10 +1637,9 @@ static void handle_player_pickups(Game *g, float dt)
     float dx = d->x - p->x;
     float dy = d->y - p->y;
     float dist2 = dx * dx + dy * dy;
-    float dist = sqrtf(dist2);
 
     float pickup_dist = (d->type == 0) ? pickup_range : (d->type == 1 ? health_pickup_range : chest_pickup_range);
-    if (dist < pickup_dist)
+    if (dist2 < pickup_dist * pickup_dist)
     {
       if (d->type == 0)
       {
@@ -1571,24 +1679,10 @@ static void handle_player_pickups(Game *g, float dt)
     }
 
     /* Once magnetized, keep flying until picked up */
-    if (d->type != 2 && (dist < xp_magnet_range || d->magnetized))
-    {
+    if (d->type != 2 && dist2 < xp_magnet_range * xp_magnet_range)
       d->magnetized = 1;
-      /* Accelerate magnet speed over time */
-      d->magnet_speed += 400.0f * dt;
-      if (d->magnet_speed > 600.0f)
-        d->magnet_speed = 600.0f;
-
-      /* Move toward player */
-      if (dist > 0.0001f)
-      {
-        float nx = -dx / dist;
-        float ny = -dy / dist;
-        d->x += nx * d->magnet_speed * dt;
-        d->y += ny * d->magnet_speed * dt;
-      }
-    }
   }
+  drops_magnet_step(g, p->x, p->y, dt);
 }
 
 /* Ultimate abilities - each character can have a unique one */
@@ -1632,23 +1726,22 @@ static void apply_totem_effect(Game *g, int type)
   if (type == 0) 
   { 
     g->totem_freeze_timer = duration; 
-    for (int i = 0; i < MAX_ENEMIES; i++) 
+    for (int i = 0; i < g->caps.enemies; i++) 
     { 
       if (!g->enemies[i].active) 
         continue; 
-      if (g->enemies[i].debuffs.stun_timer < duration) 
-        g->enemies[i].debuffs.stun_timer = duration; 
+      debuff_extend(g, &g->enemies[i], DEBUFF_STUN, duration); 
     } 
     log_combatf(g, "freeze_totem activated"); 
   } 
   else if (type == 1) 
   { 
-    for (int i = 0; i < MAX_ENEMIES; i++) 
+    for (int i = 0; i < g->caps.enemies; i++) 
     { 
       Enemy *en = &g->enemies[i]; 
       if (!en->active) 
         continue; 
-      en->debuffs.curse_timer = duration; 
+      debuff_apply(g, en, DEBUFF_CURSE, duration); 
       en->debuffs.curse_dps = (en->max_hp * 0.5f) / duration; 
     } 
     log_combatf(g, "curse_totem activated"); 
@@ -1660,7 +1753,7 @@ static void apply_totem_effect(Game *g, int type)
     float cam_y = g->camera_y;
     float cam_x2 = cam_x + g->view_w;
     float cam_y2 = cam_y + g->view_h;
-    for (int i = 0; i < MAX_ENEMIES; i++)
+    for (int i = 0; i < g->caps.enemies; i++)
     {
       Enemy *en = &g->enemies[i];
       if (!en->active)
@@ -1798,7 +1891,7 @@ static void update_alchemist_ult(Game *g, float dt)
       float radius2 = radius * radius;
       int killed = 0;
       spawn_alchemist_ult_fx(g, p->x, p->y, radius);
-      for (int i = 0; i < MAX_ENEMIES; i++)
+      for (int i = 0; i < g->caps.enemies; i++)
       {
         Enemy *en = &g->enemies[i];
         if (!en->active)
@@ -1885,7 +1978,7 @@ void activate_ultimate(Game *g)
   }
 }
 
-void update_game(Game *g, float dt)
+static void wave_tick(Game *g, float dt)
 {
   const Uint8 *keys = SDL_GetKeyboardState(NULL);
   Player *p = &g->player;
@@ -1993,11 +2086,31 @@ void update_game(Game *g, float dt)
   g->camera_y = clampf(g->camera_y, 0.0f, max_cam_y);
 
   update_sword_orbit(g, dt);
+  prof_begin(PROF_FIRE_WEAPONS);
   fire_weapons(g, dt);
+  prof_end(PROF_FIRE_WEAPONS);
+  prof_begin(PROF_UPDATE_BULLETS);
   update_bullets(g, dt);
+  prof_end(PROF_UPDATE_BULLETS);
+  prof_begin(PROF_UPDATE_ENEMY_BULLETS);
+  update_enemy_bullets(g, dt);
+  prof_end(PROF_UPDATE_ENEMY_BULLETS);
+  prof_begin(PROF_UPDATE_WEAPON_FX);
   update_weapon_fx(g, dt);
+  prof_end(PROF_UPDATE_WEAPON_FX);
+  prof_begin(PROF_UPDATE_PUDDLES);
   update_puddles(g, dt);
+  prof_end(PROF_UPDATE_PUDDLES);
+  procs_flush(g);
+  prof_begin(PROF_UPDATE_DEBUFFS);
+  debuffs_update(g, dt);
+  prof_end(PROF_UPDATE_DEBUFFS);
+  prof_begin(PROF_UPDATE_ENEMIES);
   update_enemies(g, dt);
+  prof_end(PROF_UPDATE_ENEMIES);
+  prof_begin(PROF_CROWD);
+  crowd_separate(g, dt);
+  prof_end(PROF_CROWD);
 
   if (g->mode == MODE_LEVELUP && (g->levelup_chosen >= 0 || g->levelup_selected_count > 0) && g->levelup_fade > 0.0f)
   {
@@ -2010,7 +2123,9 @@ void update_game(Game *g, float dt)
     }
   }
 
+  prof_begin(PROF_PICKUPS);
   handle_player_pickups(g, dt);
+  prof_end(PROF_PICKUPS);
 
   if (g->totem_freeze_timer > 0.0f)
   {
@@ -2031,54 +2146,14 @@ void update_game(Game *g, float dt)
     } 
   } 
 
-  /* Update game time and spawn enemies continuously */
+  /* Update game time; freeze totem pauses spawns */
   g->game_time += dt;
-  if (g->totem_freeze_timer > 0.0f)
-  {
-    /* Freeze totem pauses spawns */
-  }
-  else
-  {
-    g->spawn_timer -= dt;
-  }
-  if (g->spawn_timer <= 0.0f && g->totem_freeze_timer <= 0.0f)
-  {
-    if (g->db.enemy_count > 0)
-    {
-      int def_index = rand() % g->db.enemy_count;
-      int eye_index = find_enemy_def(&g->db, "eye");
-      int ghost_index = find_enemy_def(&g->db, "ghost");
-      if (g->game_time >= 300.0f && ghost_index >= 0)
-      {
-        def_index = ghost_index;
-      }
-      else if (g->game_time >= 180.0f && eye_index >= 0)
-      {
-        def_index = eye_index;
-      }
-      else
-      {
-        /* Every 60 seconds, spawn tougher enemy type */
-        int difficulty_tier = (int)(g->game_time / 60.0f);
-        if (difficulty_tier > 0 && frandf() < 0.2f + difficulty_tier * 0.1f)
-        {
-          def_index = (def_index + difficulty_tier) % g->db.enemy_count;
-        }
-      }
-      spawn_enemy(g, def_index);
-      /* Spawn rate increases over time */
-      float base_rate = 1.0f - g->game_time * 0.005f;
-      g->spawn_timer = clampf(base_rate * g->skill_tree_spawn_scale, 0.15f, 2.0f);
-    }
-    else
-    {
-      g->spawn_timer = 1.0f;
-    }
-  }
+  if (g->totem_freeze_timer <= 0.0f)
+    director_update(g, dt);
 
   if (p->hp <= 0.0f)
   {
-    if (g->mode != MODE_GAMEOVER)
+    if (g->mode != MODE_GAMEOVER && !g->headless)
     {
       skill_tree_award_points(g);
     }
@@ -2086,7 +2161,27 @@ void update_game(Game *g, float dt)
   }
 }
 
-void update_boss_event(Game *g, float dt)
+/* Transient query results for the tick come from tick_scratch; any heap
+   allocation until tick_end is counted (and asserts under BUH_ALLOC_CHECKS). */
+static void tick_begin(Game *g)
+{
+  scratch_reset(&g->tick_scratch);
+  alloc_guard_enter();
+}
+
+static void tick_end(void)
+{
+  alloc_guard_leave();
+}
+
+void update_game(Game *g, float dt)
+{
+  tick_begin(g);
+  wave_tick(g, dt);
+  tick_end();
+}
+
+static void boss_event_tick(Game *g, float dt)
 {
   const Uint8 *keys = SDL_GetKeyboardState(NULL);
   Player *p = &g->player;
@@ -2239,10 +2334,22 @@ void update_boss_event(Game *g, float dt)
   g->camera_y = clampf(g->camera_y, 0.0f, max_cam_y);
 
   update_sword_orbit(g, dt);
+  prof_begin(PROF_FIRE_WEAPONS);
   fire_weapons(g, dt);
+  prof_end(PROF_FIRE_WEAPONS);
+  prof_begin(PROF_UPDATE_BULLETS);
   update_bullets(g, dt);
+  prof_end(PROF_UPDATE_BULLETS);
+  prof_begin(PROF_UPDATE_ENEMY_BULLETS);
+  update_enemy_bullets(g, dt);
+  prof_end(PROF_UPDATE_ENEMY_BULLETS);
+  prof_begin(PROF_UPDATE_WEAPON_FX);
   update_weapon_fx(g, dt);
+  prof_end(PROF_UPDATE_WEAPON_FX);
+  prof_begin(PROF_UPDATE_PUDDLES);
   update_puddles(g, dt);
+  prof_end(PROF_UPDATE_PUDDLES);
+  procs_flush(g);
 
   if (g->boss.active)
   {
@@ -2284,17 +2391,14 @@ void update_boss_event(Game *g, float dt)
     float angle = g->boss.beam_angle;
     float lx = cosf(angle);
     float ly = sinf(angle);
-    float proj = dx * lx + dy * ly;
-    if (proj > 0.0f && proj < def->beam_length)
+    float half_len = def->beam_length * 0.5f;
+    if (geom_in_obb(p->x, p->y, g->boss.x + lx * half_len, g->boss.y + ly * half_len, lx, ly, half_len,
+                    def->beam_width * 0.5f))
     {
-      float perp = fabsf(dx * (-ly) + dy * lx);
-      if (perp <= def->beam_width * 0.5f)
-      { 
-        float dmg = damage_after_armor(def->beam_dps * dt, stats.armor); 
-        if (!player_immune) 
-          p->hp -= player_damage_reduce(g, dmg); 
-      } 
-    } 
+      float dmg = damage_after_armor(def->beam_dps * dt, stats.armor);
+      if (!player_immune)
+        p->hp -= player_damage_reduce(g, dmg);
+    }
 
     int hazard_active = 0;
     if (g->boss.hazard_timer > 0.0f)
@@ -2372,8 +2476,7 @@ void update_boss_event(Game *g, float dt)
         float a = (6.28318f * i) / n;
         float vx = cosf(a) * def->wave_speed;
         float vy = sinf(a) * def->wave_speed;
-        spawn_bullet(g, g->boss.x, g->boss.y, vx, vy, def->damage * 0.7f, 0, 0, 0,
-                     -1, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        spawn_enemy_bullet(g, g->boss.x, g->boss.y, vx, vy, def->damage * 0.7f);
       }
       g->boss.wave_cd = def->wave_cooldown;
     }
@@ -2399,6 +2502,13 @@ void update_boss_event(Game *g, float dt)
   }
 }
 
+void update_boss_event(Game *g, float dt)
+{
+  tick_begin(g);
+  boss_event_tick(g, dt);
+  tick_end();
+}
+
 static void layout_levelup(Game *g, int screen_w, int screen_h)
 {
   int card_w = 260;
@@ -2417,8 +2527,9 @@ static void layout_levelup(Game *g, int screen_w, int screen_h)
   }
 }
 
-void render_game(Game *g)
+static void render_frame(Game *g)
 {
+  prof_begin(PROF_RENDER_WORLD);
   SDL_SetRenderDrawColor(g->renderer, 8, 10, 16, 255);
   SDL_RenderClear(g->renderer);
 
@@ -2432,22 +2543,10 @@ void render_game(Game *g)
   int offset_x = 0;
   int offset_y = 0;
 
-  /* Arena background - tile 128x128 ground texture with camera offset */
-  /* Buffer of 2 tiles beyond visible area for smoother scrolling */
-  if (g->tex_ground)
+  /* Arena background - ground variants and decals, one geometry batch per layer */
+  if (g->ground.atlas)
   {
-    int tile_size = 128;
-    int buffer = tile_size * 2; /* 2 extra tiles on each side */
-    int start_tx = ((cam_x - buffer) / tile_size) * tile_size;
-    int start_ty = ((cam_y - buffer) / tile_size) * tile_size;
-    for (int ty = start_ty; ty < cam_y + view_h + buffer; ty += tile_size)
-    {
-      for (int tx = start_tx; tx < cam_x + view_w + buffer; tx += tile_size)
-      {
-        SDL_Rect dst = {offset_x + tx - cam_x, offset_y + ty - cam_y, tile_size, tile_size};
-        SDL_RenderCopy(g->renderer, g->tex_ground, NULL, &dst);
-      }
-    }
+    ground_draw(&g->ground, g->renderer, cam_x, cam_y, offset_x, offset_y, view_w, view_h);
   }
   else
   {
@@ -2488,25 +2587,25 @@ void render_game(Game *g)
           core = (SDL_Color){220, 120, 40, 140};
           glow = (SDL_Color){255, 140, 60, 90};
         }
-        if (g->puddles[i].kind == 2 && g->tex_fire_trail)
+        if (g->puddles[i].kind == 2 && game_tex(g, TEX_FIRE_TRAIL))
         {
           int tex_w = 0;
           int tex_h = 0;
-          SDL_QueryTexture(g->tex_fire_trail, NULL, NULL, &tex_w, &tex_h);
+          SDL_QueryTexture(game_tex(g, TEX_FIRE_TRAIL), NULL, NULL, &tex_w, &tex_h);
           int frame_w = tex_w / 3;
           int frame = (int)(g->game_time * 6.0f) % 3;
           SDL_Rect src = {frame * frame_w, 0, frame_w, tex_h};
           SDL_Rect dst = {px - radius, py - radius, radius * 2, radius * 2};
-          SDL_SetTextureAlphaMod(g->tex_fire_trail, 220);
-          SDL_RenderCopy(g->renderer, g->tex_fire_trail, &src, &dst);
-          SDL_SetTextureAlphaMod(g->tex_fire_trail, 255);
+          SDL_SetTextureAlphaMod(game_tex(g, TEX_FIRE_TRAIL), 220);
+          SDL_RenderCopy(g->renderer, game_tex(g, TEX_FIRE_TRAIL), &src, &dst);
+          SDL_SetTextureAlphaMod(game_tex(g, TEX_FIRE_TRAIL), 255);
         }
-        else if (g->tex_alchemist_puddle)
+        else if (game_tex(g, TEX_ALCHEMIST_PUDDLE))
         {
           SDL_Rect dst = {px - radius, py - radius, radius * 2, radius * 2};
-          SDL_SetTextureAlphaMod(g->tex_alchemist_puddle, 200);
-          SDL_RenderCopy(g->renderer, g->tex_alchemist_puddle, NULL, &dst);
-          SDL_SetTextureAlphaMod(g->tex_alchemist_puddle, 255);
+          SDL_SetTextureAlphaMod(game_tex(g, TEX_ALCHEMIST_PUDDLE), 200);
+          SDL_RenderCopy(g->renderer, game_tex(g, TEX_ALCHEMIST_PUDDLE), NULL, &dst);
+          SDL_SetTextureAlphaMod(game_tex(g, TEX_ALCHEMIST_PUDDLE), 255);
         }
         else
         {
@@ -2558,19 +2657,19 @@ void render_game(Game *g)
         SDL_Color flash = {200, 220, 255, 120};
         draw_filled_circle(g->renderer, px, py, (int)range, flash);
         /* Render lightning zone sprite */
-        if (g->tex_lightning_zone)
+        if (game_tex(g, TEX_LIGHTNING_ZONE))
         {
           int sprite_size = (int)(range * 2.0f);
           SDL_Rect dst = {px - sprite_size / 2, py - sprite_size / 2, sprite_size, sprite_size};
-          SDL_SetTextureAlphaMod(g->tex_lightning_zone, 220);
-          SDL_RenderCopy(g->renderer, g->tex_lightning_zone, NULL, &dst);
-          SDL_SetTextureAlphaMod(g->tex_lightning_zone, 255);
+          SDL_SetTextureAlphaMod(game_tex(g, TEX_LIGHTNING_ZONE), 220);
+          SDL_RenderCopy(g->renderer, game_tex(g, TEX_LIGHTNING_ZONE), NULL, &dst);
+          SDL_SetTextureAlphaMod(game_tex(g, TEX_LIGHTNING_ZONE), 255);
         }
       }
     }
   }
 
-  SDL_Texture *player_tex = g->tex_player_front;
+  SDL_Texture *player_tex = game_tex(g, TEX_PLAYER_FRONT);
   SDL_RendererFlip flip = SDL_FLIP_NONE;
   float mdx = g->player.move_dir_x;
   float mdy = g->player.move_dir_y;
@@ -2579,9 +2678,9 @@ void render_game(Game *g)
   if (g->selected_character >= 0 && g->selected_character < g->db.character_count)
   {
     sel = &g->db.characters[g->selected_character];
-    if (g->tex_character_walk[g->selected_character])
+    if (game_walk_tex(g, g->selected_character))
     {
-      player_tex = g->tex_character_walk[g->selected_character];
+      player_tex = game_walk_tex(g, g->selected_character);
       use_char_walk = 1;
     }
   }
@@ -2591,23 +2690,23 @@ void render_game(Game *g)
     {
       if (fabsf(mdy) >= fabsf(mdx))
       {
-        if (mdy < 0.0f && g->tex_player_back)
-          player_tex = g->tex_player_back;
-        else if (g->tex_player_front)
-          player_tex = g->tex_player_front;
+        if (mdy < 0.0f && game_tex(g, TEX_PLAYER_BACK))
+          player_tex = game_tex(g, TEX_PLAYER_BACK);
+        else if (game_tex(g, TEX_PLAYER_FRONT))
+          player_tex = game_tex(g, TEX_PLAYER_FRONT);
       }
       else
       {
         if (mdx < 0.0f)
-          player_tex = g->tex_player_left ? g->tex_player_left : g->tex_player_right;
+          player_tex = game_tex(g, TEX_PLAYER_LEFT) ? game_tex(g, TEX_PLAYER_LEFT) : game_tex(g, TEX_PLAYER_RIGHT);
         else
-          player_tex = g->tex_player_right ? g->tex_player_right : g->tex_player_left;
+          player_tex = game_tex(g, TEX_PLAYER_RIGHT) ? game_tex(g, TEX_PLAYER_RIGHT) : game_tex(g, TEX_PLAYER_LEFT);
       }
     }
     else
     {
-      if (g->tex_player_front)
-        player_tex = g->tex_player_front;
+      if (game_tex(g, TEX_PLAYER_FRONT))
+        player_tex = game_tex(g, TEX_PLAYER_FRONT);
     }
   }
 
@@ -2654,11 +2753,25 @@ void render_game(Game *g)
 
   draw_sword_orbit(g, offset_x, offset_y, cam_x, cam_y);
 
-  /* Enemies with sprite */
-  for (int i = 0; i < MAX_ENEMIES; i++)
+  /* Enemies with sprite; only those near the view are drawn */
+  int *visible = SCRATCH_NEW(&g->frame_scratch, int, g->caps.enemies);
+  int visible_count = 0;
+  if (visible)
   {
-    if (!g->enemies[i].active)
-      continue;
+    float min_x = g->camera_x - RENDER_CULL_MARGIN;
+    float min_y = g->camera_y - RENDER_CULL_MARGIN;
+    float max_x = g->camera_x + view_w + RENDER_CULL_MARGIN;
+    float max_y = g->camera_y + view_h + RENDER_CULL_MARGIN;
+    for (int i = 0; i < g->caps.enemies; i++)
+    {
+      Enemy *e = &g->enemies[i];
+      if (e->active && e->x >= min_x && e->x <= max_x && e->y >= min_y && e->y <= max_y)
+        visible[visible_count++] = i;
+    }
+  }
+  for (int v = 0; v < visible_count; v++)
+  {
+    int i = visible[v];
     EnemyDef *def = &g->db.enemies[g->enemies[i].def_index];
     int ex = (int)(offset_x + g->enemies[i].x - cam_x);
     int ey = (int)(offset_y + g->enemies[i].y - cam_y);
@@ -2668,7 +2781,7 @@ void render_game(Game *g)
       size = 96;
 
     /* Status effect visuals - burn glow only */
-    if (g->enemies[i].debuffs.burn_timer > 0.0f)
+    if (debuff_active(g, &g->enemies[i], DEBUFF_BURN))
     {
       draw_glow(g->renderer, ex, ey, size / 2 + 8, (SDL_Color){255, 100, 0, 100});
     }
@@ -2678,27 +2791,27 @@ void render_game(Game *g)
     int hit_flash = (hit_age >= 0.0f && hit_age < 0.5f);
 
     /* Draw enemy sprite with color tint for slow */
-    SDL_Texture *enemy_tex = g->tex_enemy;
+    SDL_Texture *enemy_tex = game_tex(g, TEX_ENEMY);
     int use_charger_anim = 0;
     int use_base_anim = 0;
     int use_ghost_anim = 0;
     int use_eye_anim = 0;
-    if (strcmp(def->id, "eye") == 0 && g->tex_enemy_eye)
+    if (strcmp(def->id, "eye") == 0 && game_tex(g, TEX_ENEMY_EYE))
     {
-      enemy_tex = g->tex_enemy_eye;
+      enemy_tex = game_tex(g, TEX_ENEMY_EYE);
       use_eye_anim = 1;
     }
-    if (strcmp(def->id, "ghost") == 0 && g->tex_enemy_ghost)
+    if (strcmp(def->id, "ghost") == 0 && game_tex(g, TEX_ENEMY_GHOST))
     {
-      enemy_tex = g->tex_enemy_ghost;
+      enemy_tex = game_tex(g, TEX_ENEMY_GHOST);
       use_ghost_anim = 1;
     }
-    if (strcmp(def->id, "charger") == 0 && g->tex_enemy_charger)
+    if (strcmp(def->id, "charger") == 0 && game_tex(g, TEX_ENEMY_CHARGER))
     {
-      enemy_tex = g->tex_enemy_charger;
+      enemy_tex = game_tex(g, TEX_ENEMY_CHARGER);
       use_charger_anim = 1;
     }
-    else if (enemy_tex == g->tex_enemy)
+    else if (enemy_tex == game_tex(g, TEX_ENEMY))
     {
       use_base_anim = 1;
     }
@@ -2714,7 +2827,7 @@ void render_game(Game *g)
           move_dx = g->enemies[i].vx;
           move_dy = g->enemies[i].vy;
         }
-        else if (g->enemies[i].debuffs.stun_timer <= 0.0f)
+        else if (!debuff_active(g, &g->enemies[i], DEBUFF_STUN))
         {
           move_dx = g->player.x - g->enemies[i].x;
           move_dy = g->player.y - g->enemies[i].y;
@@ -2734,7 +2847,7 @@ void render_game(Game *g)
       {
         SDL_SetTextureColorMod(enemy_tex, 140, 180, 255);
       }
-      else if (g->enemies[i].debuffs.slow_timer > 0.0f)
+      else if (debuff_active(g, &g->enemies[i], DEBUFF_SLOW))
       {
         SDL_SetTextureColorMod(enemy_tex, 150, 180, 255);
       }
@@ -2766,7 +2879,7 @@ void render_game(Game *g)
       {
         draw_filled_circle(g->renderer, ex, ey, size / 2, (SDL_Color){220, 100, 100, 255});
       }
-      else if (g->enemies[i].debuffs.slow_timer > 0.0f)
+      else if (debuff_active(g, &g->enemies[i], DEBUFF_SLOW))
       {
         draw_filled_circle(g->renderer, ex, ey, size / 2, (SDL_Color){100, 150, 200, 255});
       }
@@ -2813,10 +2926,10 @@ void render_game(Game *g)
     int by = (int)(offset_y + g->boss.y - cam_y);
     int br = (int)def->radius;
     draw_glow(g->renderer, bx, by, br + 14, (SDL_Color){255, 120, 60, 140});
-    if (g->tex_boss)
+    if (game_tex(g, TEX_BOSS))
     {
       SDL_Rect dst = {bx - br * 2, by - br * 2, br * 4, br * 4};
-      SDL_RenderCopy(g->renderer, g->tex_boss, NULL, &dst);
+      SDL_RenderCopy(g->renderer, game_tex(g, TEX_BOSS), NULL, &dst);
     }
     else
     {
@@ -2851,11 +2964,11 @@ void render_game(Game *g)
     SDL_Point pivot = {0, beam_w / 2};
     double angle_deg = angle * (180.0 / 3.14159);
     SDL_SetRenderDrawBlendMode(g->renderer, SDL_BLENDMODE_BLEND);
-    if (g->tex_laser_beam)
+    if (game_tex(g, TEX_LASER_BEAM))
     {
-      SDL_SetTextureAlphaMod(g->tex_laser_beam, 220);
-      SDL_RenderCopyEx(g->renderer, g->tex_laser_beam, NULL, &dst, angle_deg, &pivot, SDL_FLIP_NONE);
-      SDL_SetTextureAlphaMod(g->tex_laser_beam, 255);
+      SDL_SetTextureAlphaMod(game_tex(g, TEX_LASER_BEAM), 220);
+      SDL_RenderCopyEx(g->renderer, game_tex(g, TEX_LASER_BEAM), NULL, &dst, angle_deg, &pivot, SDL_FLIP_NONE);
+      SDL_SetTextureAlphaMod(game_tex(g, TEX_LASER_BEAM), 255);
     }
     else
     {
@@ -2891,30 +3004,40 @@ void render_game(Game *g)
   }
 
   /* Bullets with trails */
-  for (int i = 0; i < MAX_BULLETS; i++)
+  for (unsigned int k = g->bullet_ring.head; k != g->bullet_ring.tail; k++)
   {
+    int i = (int)(k & g->bullet_ring.mask);
     if (!g->bullets[i].active)
       continue;
-    int bx = (int)(offset_x + g->bullets[i].x - cam_x);
-    int by = (int)(offset_y + g->bullets[i].y - cam_y);
-    if (g->bullets[i].from_player)
+    float wx = g->bullet_ring.x[i];
+    float wy = g->bullet_ring.y[i];
+    if (g->interp.applied)
     {
-      draw_glow(g->renderer, bx, by, 8, (SDL_Color){100, 220, 255, 80});
-      draw_filled_circle(g->renderer, bx, by, 4, (SDL_Color){150, 230, 255, 255});
+      wx = g->bullet_ring.px[i] + (wx - g->bullet_ring.px[i]) * g->interp.alpha;
+      wy = g->bullet_ring.py[i] + (wy - g->bullet_ring.py[i]) * g->interp.alpha;
+    }
+    int bx = (int)(offset_x + wx - cam_x);
+    int by = (int)(offset_y + wy - cam_y);
+    draw_glow(g->renderer, bx, by, 8, (SDL_Color){100, 220, 255, 80});
+    draw_filled_circle(g->renderer, bx, by, 4, (SDL_Color){150, 230, 255, 255});
+  }
+  /* Enemy shots keep no previous position; step them back along their velocity. */
+  float shot_back = g->interp.applied ? (1.0f - g->interp.alpha) * g->time_scale / 60.0f : 0.0f;
+  for (int i = 0; i < g->enemy_bullet_count; i++)
+  {
+    const EnemyBullet *eb = &g->enemy_bullets[i];
+    int bx = (int)(offset_x + eb->x - eb->vx * shot_back - cam_x);
+    int by = (int)(offset_y + eb->y - eb->vy * shot_back - cam_y);
+    /* Enemy projectile - use goo_bolt sprite */
+    if (game_tex(g, TEX_ENEMY_BOLT))
+    {
+      SDL_Rect dst = {bx - 16, by - 16, 32, 32};
+      SDL_RenderCopy(g->renderer, game_tex(g, TEX_ENEMY_BOLT), NULL, &dst);
     }
     else
     {
-      /* Enemy projectile - use goo_bolt sprite */
-      if (g->tex_enemy_bolt)
-      {
-        SDL_Rect dst = {bx - 16, by - 16, 32, 32};
-        SDL_RenderCopy(g->renderer, g->tex_enemy_bolt, NULL, &dst);
-      }
-      else
-      {
-        draw_glow(g->renderer, bx, by, 8, (SDL_Color){255, 100, 100, 80});
-        draw_filled_circle(g->renderer, bx, by, 4, (SDL_Color){255, 120, 120, 255});
-      }
+      draw_glow(g->renderer, bx, by, 8, (SDL_Color){255, 100, 100, 80});
+      draw_filled_circle(g->renderer, bx, by, 4, (SDL_Color){255, 120, 120, 255});
     }
   }
 
@@ -2934,13 +3057,13 @@ void render_game(Game *g)
       int draw_y = (int)(offset_y + sy - cam_y);
       int scythe_size = 64;
       int alpha = 220;
-      if (g->tex_scythe)
+      if (game_tex(g, TEX_SCYTHE))
       {
         SDL_Rect dst = {draw_x - scythe_size / 2, draw_y - scythe_size / 2, scythe_size, scythe_size};
         double angle_deg = fx->angle * (180.0 / 3.14159);
-        SDL_SetTextureAlphaMod(g->tex_scythe, (Uint8)alpha);
-        SDL_RenderCopyEx(g->renderer, g->tex_scythe, NULL, &dst, angle_deg + 90, NULL, SDL_FLIP_NONE);
-        SDL_SetTextureAlphaMod(g->tex_scythe, 255);
+        SDL_SetTextureAlphaMod(game_tex(g, TEX_SCYTHE), (Uint8)alpha);
+        SDL_RenderCopyEx(g->renderer, game_tex(g, TEX_SCYTHE), NULL, &dst, angle_deg + 90, NULL, SDL_FLIP_NONE);
+        SDL_SetTextureAlphaMod(game_tex(g, TEX_SCYTHE), 255);
       }
       else
       {
@@ -2953,7 +3076,7 @@ void render_game(Game *g)
     {
       /* Vampire bite - appears on enemy */
       int target = fx->target_enemy;
-      if (target >= 0 && target < MAX_ENEMIES && g->enemies[target].active)
+      if (target >= 0 && target < g->caps.enemies && g->enemies[target].active)
       {
         int ex = (int)(offset_x + g->enemies[target].x - cam_x);
         int ey = (int)(offset_y + g->enemies[target].y - cam_y);
@@ -2961,12 +3084,12 @@ void render_game(Game *g)
         float scale = 0.5f + progress * 0.5f; /* Grow from 0.5 to 1.0 */
         int size = (int)(96 * scale);         /* 3x bigger (was 32) */
 
-        if (g->tex_bite)
+        if (game_tex(g, TEX_BITE))
         {
           SDL_Rect dst = {ex - size / 2, ey - size / 2, size, size};
-          SDL_SetTextureAlphaMod(g->tex_bite, (Uint8)alpha);
-          SDL_RenderCopy(g->renderer, g->tex_bite, NULL, &dst);
-          SDL_SetTextureAlphaMod(g->tex_bite, 255);
+          SDL_SetTextureAlphaMod(game_tex(g, TEX_BITE), (Uint8)alpha);
+          SDL_RenderCopy(g->renderer, game_tex(g, TEX_BITE), NULL, &dst);
+          SDL_SetTextureAlphaMod(game_tex(g, TEX_BITE), 255);
         }
         else
         {
@@ -2983,7 +3106,7 @@ void render_game(Game *g)
     {
       /* Dagger throw - travels from player to target */
       int target = fx->target_enemy;
-      if (target >= 0 && target < MAX_ENEMIES)
+      if (target >= 0 && target < g->caps.enemies)
       {
         float start_x = fx->x;
         float start_y = fx->y;
@@ -2998,13 +3121,13 @@ void render_game(Game *g)
         int dy = (int)(offset_y + curr_y - cam_y);
         int alpha = progress < 0.8f ? 255 : (int)(255 * (1.0f - (progress - 0.8f) / 0.2f));
 
-        if (g->tex_dagger)
+        if (game_tex(g, TEX_DAGGER))
         {
           SDL_Rect dst = {dx - 12, dy - 12, 24, 24};
           double angle_deg = fx->angle * (180.0 / 3.14159);
-          SDL_SetTextureAlphaMod(g->tex_dagger, (Uint8)alpha);
-          SDL_RenderCopyEx(g->renderer, g->tex_dagger, NULL, &dst, angle_deg + 90, NULL, SDL_FLIP_NONE);
-          SDL_SetTextureAlphaMod(g->tex_dagger, 255);
+          SDL_SetTextureAlphaMod(game_tex(g, TEX_DAGGER), (Uint8)alpha);
+          SDL_RenderCopyEx(g->renderer, game_tex(g, TEX_DAGGER), NULL, &dst, angle_deg + 90, NULL, SDL_FLIP_NONE);
+          SDL_SetTextureAlphaMod(game_tex(g, TEX_DAGGER), 255);
         }
         else
         {
@@ -3030,12 +3153,12 @@ void render_game(Game *g)
       if (size < 8)
         size = 8;
 
-      if (g->tex_alchemist_ult)
+      if (game_tex(g, TEX_ALCHEMIST_ULT))
       {
         SDL_Rect dst = {ex - size / 2, ey - size / 2, size, size};
-        SDL_SetTextureAlphaMod(g->tex_alchemist_ult, (Uint8)alpha);
-        SDL_RenderCopy(g->renderer, g->tex_alchemist_ult, NULL, &dst);
-        SDL_SetTextureAlphaMod(g->tex_alchemist_ult, 255);
+        SDL_SetTextureAlphaMod(game_tex(g, TEX_ALCHEMIST_ULT), (Uint8)alpha);
+        SDL_RenderCopy(g->renderer, game_tex(g, TEX_ALCHEMIST_ULT), NULL, &dst);
+        SDL_SetTextureAlphaMod(game_tex(g, TEX_ALCHEMIST_ULT), 255);
       }
       else
       {
@@ -3058,11 +3181,11 @@ void render_game(Game *g)
       int tx = (int)(offset_x + t->x - cam_x);
       int ty = (int)(offset_y + t->y - cam_y);
       int size = 72;
-      SDL_Texture *tex = g->tex_totem_freeze;
+      SDL_Texture *tex = game_tex(g, TEX_TOTEM_FREEZE);
       if (t->type == 1)
-        tex = g->tex_totem_curse;
+        tex = game_tex(g, TEX_TOTEM_CURSE);
       else if (t->type == 2)
-        tex = g->tex_totem_damage;
+        tex = game_tex(g, TEX_TOTEM_DAMAGE);
       if (tex)
       {
         SDL_Rect dst = {tx - size / 2, ty - size / 2, size, size};
@@ -3149,7 +3272,7 @@ void render_game(Game *g)
   } 
 
   /* Drops with sparkle effect */
-  for (int i = 0; i < MAX_DROPS; i++)
+  for (int i = 0; i < g->caps.drops; i++)
   {
     if (!g->drops[i].active)
       continue;
@@ -3157,25 +3280,27 @@ void render_game(Game *g)
     int dy = (int)(offset_y + g->drops[i].y - cam_y);
     if (g->drops[i].type == 0)
     {
-      /* XP orb (0.6x size) */
-      if (g->tex_exp_orb)
+      /* XP orb (0.6x size), larger once it has absorbed others */
+      float orb_scale = drop_xp_scale(g->drops[i].value);
+      if (game_tex(g, TEX_EXP_ORB))
       {
-        SDL_Rect dst = {dx - 7, dy - 7, 14, 14};
-        SDL_RenderCopy(g->renderer, g->tex_exp_orb, NULL, &dst);
+        int size = (int)(14.0f * orb_scale);
+        SDL_Rect dst = {dx - size / 2, dy - size / 2, size, size};
+        SDL_RenderCopy(g->renderer, game_tex(g, TEX_EXP_ORB), NULL, &dst);
       }
       else
       {
-        draw_glow(g->renderer, dx, dy, 6, (SDL_Color){80, 180, 255, 80});
-        draw_filled_circle(g->renderer, dx, dy, 3, (SDL_Color){100, 200, 255, 255});
+        draw_glow(g->renderer, dx, dy, (int)(6.0f * orb_scale), (SDL_Color){80, 180, 255, 80});
+        draw_filled_circle(g->renderer, dx, dy, (int)(3.0f * orb_scale), (SDL_Color){100, 200, 255, 255});
       }
     }
     else if (g->drops[i].type == 1)
     {
       /* Health pack */
-      if (g->tex_health_flask)
+      if (game_tex(g, TEX_HEALTH_FLASK))
       {
         SDL_Rect dst = {dx - 10, dy - 10, 20, 20};
-        SDL_RenderCopy(g->renderer, g->tex_health_flask, NULL, &dst);
+        SDL_RenderCopy(g->renderer, game_tex(g, TEX_HEALTH_FLASK), NULL, &dst);
       }
       else
       {
@@ -3190,11 +3315,11 @@ void render_game(Game *g)
       int glow_r = (int)(22 + pulse * 10);
       Uint8 glow_a = (Uint8)(120 + pulse * 80);
       draw_glow(g->renderer, dx, dy, glow_r, (SDL_Color){255, 200, 90, glow_a});
-      if (g->tex_chest)
+      if (game_tex(g, TEX_CHEST))
       {
         int size = 64;
         SDL_Rect dst = {dx - size / 2, dy - size / 2, size, size};
-        SDL_RenderCopy(g->renderer, g->tex_chest, NULL, &dst);
+        SDL_RenderCopy(g->renderer, game_tex(g, TEX_CHEST), NULL, &dst);
       }
       else
       {
@@ -3212,6 +3337,8 @@ void render_game(Game *g)
 
   /* Reset clip rect for UI */
   SDL_RenderSetClipRect(g->renderer, NULL);
+  prof_end(PROF_RENDER_WORLD);
+  prof_begin(PROF_RENDER_UI);
 
   SDL_Color text = {230, 231, 234, 255};
   char buf[128];
@@ -3251,7 +3378,7 @@ void render_game(Game *g)
   snprintf(buf, sizeof(buf), "Kills %d", g->kills);
   draw_text(g->renderer, g->font, 520, 10, text, buf);
   int enemies_alive = 0;
-  for (int i = 0; i < MAX_ENEMIES; i++)
+  for (int i = 0; i < g->caps.enemies; i++)
   {
     if (g->enemies[i].active)
       enemies_alive++;
@@ -3705,17 +3832,20 @@ void render_game(Game *g)
       show_weapons = max_visible;
       extra_weapons = 1;
     }
-    int item_counts[MAX_ITEMS] = {0};
-    int unique_indices[MAX_ITEMS];
+    int unique_counts[MAX_PASSIVE_ITEMS] = {0};
+    int unique_indices[MAX_PASSIVE_ITEMS];
     int unique_count = 0;
     for (int i = 0; i < g->player.passive_count; i++)
     {
       int idx = g->player.passive_items[i];
       if (idx < 0 || idx >= g->db.item_count)
         continue;
-      if (item_counts[idx] == 0)
+      int u = 0;
+      while (u < unique_count && unique_indices[u] != idx)
+        u++;
+      if (u == unique_count)
         unique_indices[unique_count++] = idx;
-      item_counts[idx]++;
+      unique_counts[u]++;
     }
     int show_items = unique_count;
     int extra_more = 0;
@@ -3809,9 +3939,9 @@ void render_game(Game *g)
         {
           hovered_item_index = idx;
         }
-        if (item_counts[idx] > 1)
+        if (unique_counts[i] > 1)
         {
-          snprintf(buf, sizeof(buf), "%s x%d", it->name, item_counts[idx]);
+          snprintf(buf, sizeof(buf), "%s x%d", it->name, unique_counts[i]);
           draw_text(g->renderer, g->font, panel_x + 12, py, rc, buf);
         }
         else
@@ -3952,9 +4082,9 @@ void render_game(Game *g)
       CharacterDef *c = &g->db.characters[char_idx];
 
       /* Portrait fills the entire card */
-      if (g->tex_portraits[char_idx])
+      if (game_portrait_tex(g, char_idx))
       {
-        SDL_RenderCopy(g->renderer, g->tex_portraits[char_idx], NULL, &r);
+        SDL_RenderCopy(g->renderer, game_portrait_tex(g, char_idx), NULL, &r);
       }
       else
       {
@@ -4002,9 +4132,9 @@ void render_game(Game *g)
       int big_portrait_w = 200;
       int big_portrait_h = 260;
       SDL_Rect big_portrait = {rx + (panel_w - big_portrait_w) / 2, ry, big_portrait_w, big_portrait_h};
-      if (g->tex_portraits[char_idx])
+      if (game_portrait_tex(g, char_idx))
       {
-        SDL_RenderCopy(g->renderer, g->tex_portraits[char_idx], NULL, &big_portrait);
+        SDL_RenderCopy(g->renderer, game_portrait_tex(g, char_idx), NULL, &big_portrait);
         /* Gold border */
         SDL_SetRenderDrawColor(g->renderer, 200, 170, 80, 255);
         SDL_RenderDrawRect(g->renderer, &big_portrait);
@@ -4762,7 +4892,23 @@ void render_game(Game *g)
     }
   }
 
+  if (g->debug_show_profiler)
+    draw_profiler_overlay(g);
+  prof_end(PROF_RENDER_UI);
+
+  prof_begin(PROF_PRESENT);
   SDL_RenderPresent(g->renderer);
+  prof_end(PROF_PRESENT);
+}
+
+/* Draws one frame with entities placed interp.alpha of the way through the
+   last tick, then restores the live state for the next update. */
+void render_game(Game *g)
+{
+  scratch_reset(&g->frame_scratch);
+  interp_begin(g);
+  render_frame(g);
+  interp_end(g);
 }
 
 void handle_levelup_click(Game *g, int mx, int my)
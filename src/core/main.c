@@ -1,12 +1,18 @@
+#include "core/bench.h"
 #include "core/game.h"
+#include "core/pools.h"
+#include "core/profiler.h"
+#include "data/data_pack.h"
+#include "data/hot_reload.h"
 #include "data/registry.h"
+#include "render/assets.h"
+#include "render/interp.h"
 #include "render/render.h"
 #include "systems/enemies.h"
+#include "systems/field.h"
 #include "systems/skill_tree.h"
 
 int main(int argc, char **argv) {
-  (void)argc;
-  (void)argv;
   SetUnhandledExceptionFilter(crash_handler);
 
   g_log = fopen("log.txt", "w");
@@ -16,6 +22,22 @@ int main(int argc, char **argv) {
   Game game;
   memset(&game, 0, sizeof(game));
 
+  if (argc >= 2 && strcmp(argv[1], "--pack") == 0) {
+    const char *out = argc >= 3 ? argv[2] : DATA_PACK_PATH;
+    if (!db_load_json(&game.db)) {
+      log_line("Pack: failed to load JSON data.");
+      return 1;
+    }
+    if (!db_write_pack(&game.db, out)) {
+      log_linef("Pack: failed to write %s", out);
+      return 1;
+    }
+    log_linef("Pack: wrote %s (weapons=%d items=%d enemies=%d characters=%d)", out, game.db.weapon_count,
+              game.db.item_count, game.db.enemy_count, game.db.character_count);
+    db_free(&game.db);
+    return 0;
+  }
+
   if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0) {
     log_linef("SDL init failed: %s", SDL_GetError());
     return 1;
@@ -38,7 +60,39 @@ int main(int argc, char **argv) {
   }
   log_linef("Counts: weapons=%d items=%d enemies=%d characters=%d",
             game.db.weapon_count, game.db.item_count, game.db.enemy_count, game.db.character_count);
-  log_line("Data load ok");
+  log_linef("Data load ok (%s)", game.db.from_pack ? DATA_PACK_PATH : "json");
+  if (load_spawn_curve(DATA_SPAWN_CURVE_PATH, game.director.phases, MAX_SPAWN_PHASES, &game.director.phase_count))
+    log_linef("Spawn curve: %d phases", game.director.phase_count);
+  else
+    log_linef("Failed to read %s, using the built-in spawn curve", DATA_SPAWN_CURVE_PATH);
+
+  /* Entity pools: --profile=low|medium|high|stress */
+  const char *profile = POOL_PROFILE_DEFAULT;
+  for (int i = 1; i < argc; i++) {
+    if (strncmp(argv[i], "--profile=", 10) == 0) profile = argv[i] + 10;
+  }
+  GameCaps caps;
+  if (!game_caps_profile(profile, &caps)) {
+    log_linef("Unknown profile '%s', using %s", profile, POOL_PROFILE_DEFAULT);
+    profile = POOL_PROFILE_DEFAULT;
+    game_caps_profile(profile, &caps);
+  }
+  if (!game_pools_init(&game, &caps)) {
+    log_linef("Failed to allocate entity pools for profile %s", profile);
+    return 1;
+  }
+  log_linef("Pools (%s): enemies=%d bullets=%d enemy_bullets=%d drops=%d, %.1f MB", profile, game.caps.enemies,
+            game.caps.bullets, game.caps.enemy_bullets, game.caps.drops,
+            (double)game.pool_arena.size / (1024.0 * 1024.0));
+
+  BenchOptions bench;
+  if (bench_parse_args(&bench, argc, argv)) {
+    run_benchmark(&game, &bench);
+    game_pools_free(&game);
+    db_free(&game.db);
+    SDL_Quit();
+    return 0;
+  }
   skill_tree_layout_load(); 
   skill_tree_progress_init(&game); 
 
@@ -88,119 +142,12 @@ int main(int argc, char **argv) {
     log_linef("Failed to load cursor.png: %s", IMG_GetError());
   }
 
-  game.tex_ground = IMG_LoadTexture(game.renderer, "data/assets/hd_ground_tile.png");
-  game.tex_wall = IMG_LoadTexture(game.renderer, "data/assets/wall.png");
-  game.tex_enemy = IMG_LoadTexture(game.renderer, "data/assets/enemies/goo_enemy.png");
-  game.tex_enemy_eye = IMG_LoadTexture(game.renderer, "data/assets/enemies/eye_enemy.png");
-  game.tex_enemy_ghost = IMG_LoadTexture(game.renderer, "data/assets/enemies/ghost_enemy.png");
-  game.tex_enemy_charger = IMG_LoadTexture(game.renderer, "data/assets/enemies/reaper_enemy.png");
-  game.tex_health_flask = IMG_LoadTexture(game.renderer, "data/assets/health_flask.png");
-  if (game.tex_health_flask) log_line("Loaded health_flask.png");
-  else log_linef("Failed to load health_flask.png: %s", IMG_GetError());
-  if (game.tex_ground) log_line("Loaded hd_ground_tile.png");
-  else log_linef("Failed to load ground.png: %s", IMG_GetError());
-  if (game.tex_wall) log_line("Loaded wall.png");
-  else log_linef("Failed to load wall.png: %s", IMG_GetError());
-  if (game.tex_enemy) log_line("Loaded goo_enemy.png");
-  else log_linef("Failed to load goo_enemy.png: %s", IMG_GetError());
-  if (game.tex_enemy_eye) log_line("Loaded enemies/eye_enemy.png");
-  else log_linef("Failed to load enemies/eye_enemy.png: %s", IMG_GetError());
-  if (game.tex_enemy_ghost) log_line("Loaded enemies/ghost_enemy.png");
-  else log_linef("Failed to load enemies/ghost_enemy.png: %s", IMG_GetError());
-  if (game.tex_enemy_charger) log_line("Loaded reaper_enemy.png");
-  else log_linef("Failed to load reaper_enemy.png: %s", IMG_GetError());
-  game.tex_boss = load_texture_fallback(game.renderer, "data/assets/fire_goo_boss.png");
-  if (game.tex_boss) log_line("Loaded fire_goo_boss.png");
-  else log_linef("Failed to load fire_goo_boss.png: %s", IMG_GetError());
-  game.tex_player_front = IMG_LoadTexture(game.renderer, "data/assets/player_front.png");
-  if (game.tex_player_front) log_line("Loaded player_front.png");
-  else log_linef("Failed to load player_front.png: %s", IMG_GetError());
-  game.tex_player_back = IMG_LoadTexture(game.renderer, "data/assets/player_back.png");
-  if (game.tex_player_back) log_line("Loaded player_back.png");
-  else log_linef("Failed to load player_back.png: %s", IMG_GetError());
-  game.tex_player_right = IMG_LoadTexture(game.renderer, "data/assets/player_right.png");
-  if (game.tex_player_right) log_line("Loaded player_right.png");
-  else log_linef("Failed to load player_right.png: %s", IMG_GetError());
-  game.tex_player_left = IMG_LoadTexture(game.renderer, "data/assets/player_left.png");
-  if (game.tex_player_left) log_line("Loaded player_left.png");
-  else log_linef("Failed to load player_left.png: %s", IMG_GetError());
-  for (int i = 0; i < game.db.character_count && i < MAX_CHARACTERS; i++) {
-    game.tex_character_walk[i] = NULL;
-    if (game.db.characters[i].walk_strip[0]) {
-      char walk_path[160];
-      snprintf(walk_path, sizeof(walk_path), "data/assets/%s", game.db.characters[i].walk_strip);
-      game.tex_character_walk[i] = IMG_LoadTexture(game.renderer, walk_path);
-      if (game.tex_character_walk[i]) log_linef("Loaded walk strip: %s", walk_path);
-      else log_linef("Failed to load walk strip %s: %s", walk_path, IMG_GetError());
-    }
-  }
-  game.tex_enemy_bolt = IMG_LoadTexture(game.renderer, "data/assets/goo_bolt.png");
-  if (game.tex_enemy_bolt) log_line("Loaded goo_bolt.png");
-  else log_linef("Failed to load goo_bolt.png: %s", IMG_GetError());
-  game.tex_laser_beam = IMG_LoadTexture(game.renderer, "data/assets/laser_beam.png");
-  if (game.tex_laser_beam) log_line("Loaded laser_beam.png");
-  else log_linef("Failed to load laser_beam.png: %s", IMG_GetError());
-  game.tex_lightning_zone = IMG_LoadTexture(game.renderer, "data/assets/lightning_zone.png");
-  if (game.tex_lightning_zone) log_line("Loaded lightning_zone.png");
-  else log_linef("Failed to load lightning_zone.png: %s", IMG_GetError());
-  game.tex_chest = IMG_LoadTexture(game.renderer, "data/assets/env/chest.png");
-  if (game.tex_chest) log_line("Loaded chest.png");
-  else log_linef("Failed to load chest.png: %s", IMG_GetError());
-  game.tex_totem_freeze = IMG_LoadTexture(game.renderer, "data/assets/env/freeze_totem.png");
-  if (game.tex_totem_freeze) log_line("Loaded freeze_totem.png");
-  else log_linef("Failed to load freeze_totem.png: %s", IMG_GetError());
-  game.tex_totem_curse = IMG_LoadTexture(game.renderer, "data/assets/env/curse_totem.png");
-  if (game.tex_totem_curse) log_line("Loaded curse_totem.png");
-  else log_linef("Failed to load curse_totem.png: %s", IMG_GetError());
-  game.tex_totem_damage = IMG_LoadTexture(game.renderer, "data/assets/env/damage_totem.png");
-  if (game.tex_totem_damage) log_line("Loaded damage_totem.png");
-  else log_linef("Failed to load damage_totem.png: %s", IMG_GetError());
-
-  game.tex_scythe = IMG_LoadTexture(game.renderer, "data/assets/weapons/scythe.png");
-  if (game.tex_scythe) log_line("Loaded scythe sprite");
-  else log_linef("Failed to load scythe sprite: %s", IMG_GetError());
-  game.tex_bite = IMG_LoadTexture(game.renderer, "data/assets/weapons/vampire_bite.png");
-  if (game.tex_bite) log_line("Loaded vampire bite sprite");
-  else log_linef("Failed to load vampire bite sprite: %s", IMG_GetError());
-  game.tex_dagger = IMG_LoadTexture(game.renderer, "data/assets/weapons/dagger.png");
-  if (game.tex_dagger) log_line("Loaded dagger sprite");
-  else log_linef("Failed to load dagger sprite: %s", IMG_GetError());
-  game.tex_alchemist_puddle = IMG_LoadTexture(game.renderer, "data/assets/weapons/alchemist_puddle.png");
-  if (game.tex_alchemist_puddle) log_line("Loaded alchemist puddle sprite");
-  else log_linef("Failed to load alchemist_puddle.png: %s", IMG_GetError());
-  game.tex_fire_trail = IMG_LoadTexture(game.renderer, "data/assets/heroes/molten/fire_trail.png");
-  if (game.tex_fire_trail) log_line("Loaded fire_trail.png");
-  else log_linef("Failed to load fire_trail.png: %s", IMG_GetError());
-  game.tex_alchemist_ult = IMG_LoadTexture(game.renderer, "data/assets/alchemist_ult.png");
-  if (game.tex_alchemist_ult) log_line("Loaded alchemist ult sprite");
-  else log_linef("Failed to load alchemist_ult.png: %s", IMG_GetError());
-  game.tex_exp_orb = IMG_LoadTexture(game.renderer, "data/assets/exp_orb.png");
-  if (game.tex_exp_orb) log_line("Loaded exp_orb sprite");
-  else log_linef("Failed to load exp_orb.png: %s", IMG_GetError());
-
-  game.tex_orb_common = load_texture_fallback(game.renderer, "data/assets/orbs_rarity/common_orb.png");
-  game.tex_orb_uncommon = load_texture_fallback(game.renderer, "data/assets/orbs_rarity/uncommon_orb.png");
-  game.tex_orb_rare = load_texture_fallback(game.renderer, "data/assets/orbs_rarity/rare_orb.png");
-  game.tex_orb_epic = load_texture_fallback(game.renderer, "data/assets/orbs_rarity/epic_orb.png");
-  game.tex_orb_legendary = load_texture_fallback(game.renderer, "data/assets/orbs_rarity/legendary_orb.png");
-  if (game.tex_orb_common) log_line("Loaded common_orb.png");
-  else log_linef("Failed to load common_orb.png: %s", IMG_GetError());
-  if (game.tex_orb_uncommon) log_line("Loaded uncommon_orb.png");
-  else log_linef("Failed to load uncommon_orb.png: %s", IMG_GetError());
-  if (game.tex_orb_rare) log_line("Loaded rare_orb.png");
-  else log_linef("Failed to load rare_orb.png: %s", IMG_GetError());
-  if (game.tex_orb_epic) log_line("Loaded epic_orb.png");
-  else log_linef("Failed to load epic_orb.png: %s", IMG_GetError());
-  if (game.tex_orb_legendary) log_line("Loaded legendary_orb.png");
-  else log_linef("Failed to load legendary_orb.png: %s", IMG_GetError());
-
-  for (int i = 0; i < game.db.character_count && i < MAX_CHARACTERS; i++) {
-    char portrait_path[128];
-    snprintf(portrait_path, sizeof(portrait_path), "data/assets/portraits/%s", game.db.characters[i].portrait);
-    game.tex_portraits[i] = IMG_LoadTexture(game.renderer, portrait_path);
-    if (game.tex_portraits[i]) log_linef("Loaded portrait: %s", game.db.characters[i].portrait);
-    else log_linef("Failed to load portrait %s: %s", game.db.characters[i].portrait, IMG_GetError());
-  }
+  ground_load(&game.ground, game.renderer);
+  game_assets_init(&game, game.renderer);
+  /* Preloaded sprites and the character-select portraits decode in parallel;
+     everything else loads the first time it is drawn. */
+  game_assets_enter_menu(&game);
+  assets_prefetch(&game.assets);
 
   game.font = TTF_OpenFont("C:/Windows/Fonts/verdana.ttf", 14);
   if (!game.font) {
@@ -229,11 +176,15 @@ int main(int argc, char **argv) {
 
   game_reset(&game);
 
+  HotReload hot_reload;
+  hot_reload_init(&hot_reload);
+
   Uint64 now = SDL_GetPerformanceCounter();
   Uint64 last = 0;
   double accumulator = 0.0;
   double frequency = (double)SDL_GetPerformanceFrequency();
   int frame_log = 0;
+  prof_init();
 
   while (game.running == 0) game.running = 1;
   log_line("Main loop start");
@@ -244,6 +195,7 @@ int main(int argc, char **argv) {
     if (frame > 0.25) frame = 0.25;
     accumulator += frame;
     update_window_view(&game);
+    hot_reload_poll(&hot_reload, &game);
 
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
@@ -326,6 +278,20 @@ int main(int argc, char **argv) {
         if (e.key.keysym.sym == SDLK_F5) {
           /* no-op: pause is only via P/TAB in wave/boss */
         }
+        if (e.key.keysym.sym == SDLK_F6) {
+          game.debug_show_profiler = !game.debug_show_profiler;
+        }
+        if (e.key.keysym.sym == SDLK_F8) {
+          game.crowd_disabled = !game.crowd_disabled;
+          log_linef("Crowd separation %s", game.crowd_disabled ? "off" : "on");
+        }
+        if (e.key.keysym.sym == SDLK_F7) {
+          char trace_path[64];
+          snprintf(trace_path, sizeof(trace_path), "trace_%u.json", (unsigned)SDL_GetTicks());
+          int n = prof_write_trace(trace_path);
+          if (n >= 0) log_linef("Wrote %d trace events to %s", n, trace_path);
+          else log_linef("Failed to write %s", trace_path);
+        }
         if (e.key.keysym.sym == SDLK_5) {
           if (game.mode == MODE_WAVE && game.boss_event_cd <= 0.0f) {
             game.boss_event_cd = 5.0f;
@@ -652,6 +618,9 @@ int main(int argc, char **argv) {
 
     const double dt = 1.0 / 60.0;
     while (accumulator >= dt) {
+      prof_begin(PROF_SIM_TICK);
+      /* Only the frame's last tick needs a start state to blend from. */
+      if (accumulator < 2.0 * dt) interp_capture(&game);
       if (game.mode == MODE_WAVE) update_game(&game, (float)(dt * game.time_scale));
       if (game.mode == MODE_BOSS_EVENT) update_boss_event(&game, (float)(dt * game.time_scale));
       if (game.mode == MODE_LEVELUP && (game.levelup_chosen >= 0 || game.levelup_selected_count > 0) && game.levelup_fade > 0.0f) {
@@ -662,54 +631,30 @@ int main(int argc, char **argv) {
           game.levelup_selected_count = 0;
         }
       }
+      prof_end(PROF_SIM_TICK);
       accumulator -= dt;
     }
 
+    int sim_running = game.mode == MODE_WAVE || game.mode == MODE_BOSS_EVENT;
+    interp_set_alpha(&game, sim_running ? (float)(accumulator / dt) : 1.0f);
     render_game(&game);
+    prof_frame_end();
     frame_log++;
     if ((frame_log % 600) == 0) {
       log_linef("Frame %d", frame_log);
     }
   }
   log_line("Main loop exit");
-
-  if (game.tex_ground) SDL_DestroyTexture(game.tex_ground);
-  if (game.tex_wall) SDL_DestroyTexture(game.tex_wall);
-  if (game.tex_health_flask) SDL_DestroyTexture(game.tex_health_flask);
-  if (game.tex_enemy) SDL_DestroyTexture(game.tex_enemy);
-  if (game.tex_enemy_eye) SDL_DestroyTexture(game.tex_enemy_eye);
-  if (game.tex_enemy_ghost) SDL_DestroyTexture(game.tex_enemy_ghost);
-  if (game.tex_boss) SDL_DestroyTexture(game.tex_boss);
-  if (game.tex_player_front) SDL_DestroyTexture(game.tex_player_front);
-  if (game.tex_player_back) SDL_DestroyTexture(game.tex_player_back);
-  if (game.tex_player_right) SDL_DestroyTexture(game.tex_player_right);
-  if (game.tex_player_left) SDL_DestroyTexture(game.tex_player_left);
-  for (int i = 0; i < game.db.character_count && i < MAX_CHARACTERS; i++) {
-    if (game.tex_character_walk[i]) SDL_DestroyTexture(game.tex_character_walk[i]);
-  }
-  if (game.tex_enemy_bolt) SDL_DestroyTexture(game.tex_enemy_bolt);
-  if (game.tex_laser_beam) SDL_DestroyTexture(game.tex_laser_beam);
-  if (game.tex_lightning_zone) SDL_DestroyTexture(game.tex_lightning_zone);
-  if (game.tex_chest) SDL_DestroyTexture(game.tex_chest);
-  if (game.tex_totem_freeze) SDL_DestroyTexture(game.tex_totem_freeze);
-  if (game.tex_totem_curse) SDL_DestroyTexture(game.tex_totem_curse);
-  if (game.tex_totem_damage) SDL_DestroyTexture(game.tex_totem_damage);
-  if (game.tex_enemy_charger) SDL_DestroyTexture(game.tex_enemy_charger);
-  if (game.tex_scythe) SDL_DestroyTexture(game.tex_scythe);
-  if (game.tex_bite) SDL_DestroyTexture(game.tex_bite);
-  if (game.tex_dagger) SDL_DestroyTexture(game.tex_dagger);
-  if (game.tex_alchemist_puddle) SDL_DestroyTexture(game.tex_alchemist_puddle);
-  if (game.tex_fire_trail) SDL_DestroyTexture(game.tex_fire_trail);
-  if (game.tex_alchemist_ult) SDL_DestroyTexture(game.tex_alchemist_ult);
-  if (game.tex_exp_orb) SDL_DestroyTexture(game.tex_exp_orb);
-  if (game.tex_orb_common) SDL_DestroyTexture(game.tex_orb_common);
-  if (game.tex_orb_uncommon) SDL_DestroyTexture(game.tex_orb_uncommon);
-  if (game.tex_orb_rare) SDL_DestroyTexture(game.tex_orb_rare);
-  if (game.tex_orb_epic) SDL_DestroyTexture(game.tex_orb_epic);
-  if (game.tex_orb_legendary) SDL_DestroyTexture(game.tex_orb_legendary);
-  for (int i = 0; i < MAX_CHARACTERS; i++) {
-    if (game.tex_portraits[i]) SDL_DestroyTexture(game.tex_portraits[i]);
+  hot_reload_close(&hot_reload);
+  {
+    int n = prof_write_trace("trace_exit.json");
+    if (n >= 0) log_linef("Wrote %d trace events to trace_exit.json", n);
   }
+
+  ground_free(&game.ground);
+  assets_free(&game.assets);
+  game_pools_free(&game);
+  db_free(&game.db);
   if (game.cursor) SDL_FreeCursor(game.cursor);
   if (game.font) TTF_CloseFont(game.font);
   if (game.font_title && game.font_title != game.font) TTF_CloseFont(game.font_title);
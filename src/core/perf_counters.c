@@ -0,0 +1,129 @@
+#define _GNU_SOURCE /* syscall() for perf_event_open */
+#include "core/perf_counters.h"
+
+#include <string.h>
+
+static int g_hw_mask = 0;
+
+static const char *g_hw_names[HW_COUNTER_COUNT] = {
+  "cycles",
+  "instructions",
+  "cache_misses",
+  "branch_misses",
+};
+
+const char *hw_counter_name(int c) {
+  if (c < 0 || c >= HW_COUNTER_COUNT) return "?";
+  return g_hw_names[c];
+}
+
+int hw_counters_available(void) {
+  return g_hw_mask;
+}
+
+#if defined(__linux__)
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/* One event group led by cycles so a single read() returns every counter. */
+static int g_hw_fd[HW_COUNTER_COUNT] = {-1, -1, -1, -1};
+static int g_hw_slot[HW_COUNTER_COUNT]; /* position of each counter in the group read */
+static int g_hw_opened = 0;
+
+static int perf_open(Uint64 config, int group_fd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = group_fd < 0 ? 1 : 0;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+int hw_counters_open(void) {
+  static const Uint64 configs[HW_COUNTER_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+  };
+  hw_counters_close();
+  g_hw_fd[HW_CYCLES] = perf_open(configs[HW_CYCLES], -1);
+  if (g_hw_fd[HW_CYCLES] < 0) return 0;
+  g_hw_mask = 1 << HW_CYCLES;
+  g_hw_slot[HW_CYCLES] = 0;
+  g_hw_opened = 1;
+  for (int c = HW_CYCLES + 1; c < HW_COUNTER_COUNT; c++) {
+    g_hw_fd[c] = perf_open(configs[c], g_hw_fd[HW_CYCLES]);
+    if (g_hw_fd[c] < 0) continue;
+    g_hw_mask |= 1 << c;
+    g_hw_slot[c] = g_hw_opened++;
+  }
+  ioctl(g_hw_fd[HW_CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(g_hw_fd[HW_CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return g_hw_mask;
+}
+
+void hw_counters_close(void) {
+  for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+    if (g_hw_fd[c] >= 0) close(g_hw_fd[c]);
+    g_hw_fd[c] = -1;
+  }
+  g_hw_mask = 0;
+  g_hw_opened = 0;
+}
+
+void hw_counters_read(HwSample *out) {
+  Uint64 buf[1 + HW_COUNTER_COUNT];
+  memset(out, 0, sizeof(*out));
+  if (!g_hw_mask) return;
+  if (read(g_hw_fd[HW_CYCLES], buf, sizeof(Uint64) * (1 + g_hw_opened)) <= 0) return;
+  for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+    if (g_hw_mask & (1 << c)) out->v[c] = buf[1 + g_hw_slot[c]];
+  }
+}
+
+#elif defined(_WIN32)
+
+#include <windows.h>
+
+/* Windows has no user-mode PMU access without a driver; per-thread cycle
+   counts are the only counter available. */
+int hw_counters_open(void) {
+  ULONG64 cycles = 0;
+  g_hw_mask = QueryThreadCycleTime(GetCurrentThread(), &cycles) ? (1 << HW_CYCLES) : 0;
+  return g_hw_mask;
+}
+
+void hw_counters_close(void) {
+  g_hw_mask = 0;
+}
+
+void hw_counters_read(HwSample *out) {
+  ULONG64 cycles = 0;
+  memset(out, 0, sizeof(*out));
+  if (!g_hw_mask) return;
+  QueryThreadCycleTime(GetCurrentThread(), &cycles);
+  out->v[HW_CYCLES] = (Uint64)cycles;
+}
+
+#else
+
+int hw_counters_open(void) {
+  return 0;
+}
+
+void hw_counters_close(void) {
+}
+
+void hw_counters_read(HwSample *out) {
+  memset(out, 0, sizeof(*out));
+}
+
+#endif
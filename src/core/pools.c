@@ -0,0 +1,151 @@
+#include "core/pools.h"
+
+#include "systems/field.h"
+
+typedef struct {
+  const char *name;
+  GameCaps caps;
+} PoolProfile;
+
+/* enemies, bullets, enemy bullets, drops */
+static const PoolProfile k_profiles[] = {
+  {"low", {1024, 256, 384, 128}},
+  {"medium", {2048, 512, 768, 256}},
+  {"high", {4096, 1024, 1536, 512}},
+  {"stress", {20480, 2048, 4096, 1024}},
+};
+
+/* Returns 0 and leaves out untouched for an unknown name. */
+int game_caps_profile(const char *name, GameCaps *out) {
+  for (size_t i = 0; i < sizeof(k_profiles) / sizeof(k_profiles[0]); i++) {
+    if (strcmp(k_profiles[i].name, name) == 0) {
+      *out = k_profiles[i].caps;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static void ring_carve(BulletRing *r, Arena *a, int n) {
+  r->x = ARENA_NEW(a, float, n);
+  r->y = ARENA_NEW(a, float, n);
+  r->px = ARENA_NEW(a, float, n);
+  r->py = ARENA_NEW(a, float, n);
+  r->vx = ARENA_NEW(a, float, n);
+  r->vy = ARENA_NEW(a, float, n);
+  r->life = ARENA_NEW(a, float, n);
+  r->flags = ARENA_NEW(a, unsigned char, n);
+  r->mask = (unsigned int)n - 1u;
+  r->head = 0;
+  r->tail = 0;
+}
+
+/* The scratch blocks are plain sub-ranges of the pool arena. */
+static void scratch_carve(Scratch *s, Arena *a, size_t size) {
+  scratch_free(s);
+  s->arena.base = (unsigned char *)arena_alloc(a, size);
+  s->arena.size = s->arena.base ? size : 0;
+}
+
+/* Lays out every pool and per-enemy table. Run once against a counting
+   arena to size the block, then again to hand out pointers into it. */
+static void pools_carve(Game *g, Arena *a) {
+  const GameCaps *c = &g->caps;
+  g->enemies = ARENA_NEW(a, Enemy, c->enemies);
+  g->chain_mark = ARENA_NEW(a, unsigned int, c->enemies);
+  g->enemy_grid.items = ARENA_NEW(a, int, c->enemies);
+  CrowdGrid *cg = &g->crowd_grid;
+  cg->start = ARENA_NEW(a, int, CROWD_GRID_COLS * CROWD_GRID_ROWS + 1);
+  cg->ids = ARENA_NEW(a, int, c->enemies + CROWD_SCAN_PAD);
+  cg->cell = ARENA_NEW(a, int, c->enemies);
+  cg->gen = ARENA_NEW(a, unsigned int, c->enemies);
+  cg->x = ARENA_NEW(a, float, c->enemies + CROWD_SCAN_PAD);
+  cg->y = ARENA_NEW(a, float, c->enemies + CROWD_SCAN_PAD);
+  g->targeting.onscreen = ARENA_NEW(a, int, c->enemies);
+  DebuffSystem *d = &g->debuffs;
+  d->next = ARENA_NEW(a, int, c->enemies);
+  d->prev = ARENA_NEW(a, int, c->enemies);
+  d->due = ARENA_NEW(a, unsigned int, c->enemies);
+  d->level = ARENA_NEW(a, signed char, c->enemies);
+  d->active = ARENA_NEW(a, int, c->enemies);
+  d->active_pos = ARENA_NEW(a, int, c->enemies);
+  for (int i = 0; i < MAX_HIT_OVERFLOW; i++) {
+    g->hit_overflow[i].bits = ARENA_NEW(a, unsigned int, hit_overflow_words(g));
+  }
+  g->bullets = ARENA_NEW(a, Bullet, c->bullets);
+  ring_carve(&g->bullet_ring, a, c->bullets);
+  g->enemy_bullets = ARENA_NEW(a, EnemyBullet, c->enemy_bullets);
+  g->drops = ARENA_NEW(a, Drop, c->drops);
+
+  WaveSnapshot *s = &g->wave_snapshot;
+  s->enemies = ARENA_NEW(a, Enemy, c->enemies);
+  s->bullets = ARENA_NEW(a, Bullet, c->bullets);
+  ring_carve(&s->bullet_ring, a, c->bullets);
+  s->enemy_bullets = ARENA_NEW(a, EnemyBullet, c->enemy_bullets);
+  s->drops = ARENA_NEW(a, Drop, c->drops);
+
+  RenderInterp *ri = &g->interp;
+  ri->enemy_x = ARENA_NEW(a, float, c->enemies);
+  ri->enemy_y = ARENA_NEW(a, float, c->enemies);
+  ri->enemy_gen = ARENA_NEW(a, unsigned int, c->enemies);
+
+  size_t list_bytes = sizeof(int) * (size_t)c->enemies;
+  size_t tick_bytes = TICK_SCRATCH_BASE_BYTES + TICK_SCRATCH_ENEMY_LISTS * (list_bytes + ARENA_ALIGN);
+  size_t frame_bytes = FRAME_SCRATCH_BASE_BYTES + FRAME_SCRATCH_ENEMY_LISTS * (list_bytes + ARENA_ALIGN);
+  scratch_carve(&g->tick_scratch, a, tick_bytes);
+  scratch_carve(&g->frame_scratch, a, frame_bytes);
+}
+
+static int round_pow2(int n) {
+  int p = 1;
+  while (p < n) p <<= 1;
+  return p;
+}
+
+/* Allocates every entity pool from one arena sized for caps. Pools start
+   zeroed (all slots inactive); the debuff tables reset lazily as before. */
+int game_pools_init(Game *g, const GameCaps *caps) {
+  game_pools_free(g);
+  GameCaps c = *caps;
+  if (c.enemies < 32) c.enemies = 32;
+  if (c.enemies > ENEMY_CAP_LIMIT) c.enemies = ENEMY_CAP_LIMIT;
+  c.bullets = round_pow2(c.bullets < 16 ? 16 : c.bullets);
+  if (c.enemy_bullets < 16) c.enemy_bullets = 16;
+  if (c.drops < 16) c.drops = 16;
+  g->caps = c;
+
+  Arena measure = {0};
+  pools_carve(g, &measure);
+  if (!arena_init(&g->pool_arena, measure.used)) {
+    memset(&g->caps, 0, sizeof(g->caps));
+    return 0;
+  }
+  pools_carve(g, &g->pool_arena);
+  /* The damage field is fixed-size; reserve it now rather than on the first tick. */
+  if (!damage_field_reserve(&g->field)) {
+    game_pools_free(g);
+    return 0;
+  }
+  g->debuffs.ready = 0;
+  g->enemy_alloc_cursor = 0;
+  g->enemy_bullet_count = 0;
+  return 1;
+}
+
+void game_pools_free(Game *g) {
+  scratch_free(&g->tick_scratch);
+  scratch_free(&g->frame_scratch);
+  damage_field_free(&g->field);
+  arena_free(&g->pool_arena);
+  memset(&g->caps, 0, sizeof(g->caps));
+  g->enemies = NULL;
+  g->chain_mark = NULL;
+  g->bullets = NULL;
+  g->enemy_bullets = NULL;
+  g->drops = NULL;
+  memset(&g->bullet_ring, 0, sizeof(g->bullet_ring));
+  memset(&g->crowd_grid, 0, sizeof(g->crowd_grid));
+  g->wave_snapshot.valid = 0;
+  memset(&g->interp, 0, sizeof(g->interp));
+  g->debuffs.ready = 0;
+}
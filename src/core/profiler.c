@@ -0,0 +1,164 @@
+#include "core/profiler.h"
+
+#include <stdio.h>
+#include <string.h>
+
+Profiler g_prof;
+
+static const char *g_zone_names[PROF_ZONE_COUNT] = {
+  "sim_tick",
+  "fire_weapons",
+  "update_bullets",
+  "update_enemy_bullets",
+  "update_weapon_fx",
+  "update_puddles",
+  "update_debuffs",
+  "update_enemies",
+  "crowd_separation",
+  "pickups",
+  "render_world",
+  "render_ui",
+  "present",
+};
+
+void prof_init(void) {
+  memset(&g_prof, 0, sizeof(g_prof));
+  g_prof.ms_per_count = 1000.0 / (double)SDL_GetPerformanceFrequency();
+  g_prof.last_frame = SDL_GetPerformanceCounter();
+  g_prof.origin = g_prof.last_frame;
+}
+
+/* Opens the hardware counters and starts attributing them to zones. */
+int prof_hw_enable(void) {
+  int mask = hw_counters_open();
+  g_prof.hw_enabled = mask != 0;
+  memset(g_prof.hw_total, 0, sizeof(g_prof.hw_total));
+  return mask;
+}
+
+void prof_hw_disable(void) {
+  g_prof.hw_enabled = 0;
+  hw_counters_close();
+}
+
+static void prof_push_event(int zone, Uint64 start, Uint64 end, int ticks) {
+  ProfEvent *ev = &g_prof.events[g_prof.event_head];
+  ev->start = start;
+  ev->end = end;
+  ev->zone = zone;
+  ev->ticks = ticks;
+  g_prof.event_head = (g_prof.event_head + 1) % PROF_TRACE_EVENTS;
+  if (g_prof.event_count < PROF_TRACE_EVENTS) g_prof.event_count++;
+}
+
+void prof_begin(ProfZone z) {
+  if (g_prof.hw_enabled) hw_counters_read(&g_prof.hw_start[z]);
+  g_prof.zone_start[z] = SDL_GetPerformanceCounter();
+}
+
+void prof_end(ProfZone z) {
+  Uint64 now = SDL_GetPerformanceCounter();
+  if (g_prof.hw_enabled) {
+    HwSample hw;
+    hw_counters_read(&hw);
+    for (int c = 0; c < HW_COUNTER_COUNT; c++) g_prof.hw_total[z][c] += hw.v[c] - g_prof.hw_start[z].v[c];
+  }
+  g_prof.zone_accum[z] += now - g_prof.zone_start[z];
+  g_prof.zone_total[z] += now - g_prof.zone_start[z];
+  g_prof.zone_calls[z]++;
+  prof_push_event(z, g_prof.zone_start[z], now, 0);
+  if (z == PROF_SIM_TICK) g_prof.sim_ticks++;
+}
+
+/* Commits everything accumulated since the previous call as one frame. */
+void prof_frame_end(void) {
+  if (g_prof.ms_per_count <= 0.0) prof_init();
+  Uint64 now = SDL_GetPerformanceCounter();
+  ProfFrame *f = &g_prof.frames[g_prof.head];
+  f->frame_ms = (float)((double)(now - g_prof.last_frame) * g_prof.ms_per_count);
+  for (int z = 0; z < PROF_ZONE_COUNT; z++) {
+    f->zone_ms[z] = (float)((double)g_prof.zone_accum[z] * g_prof.ms_per_count);
+    g_prof.zone_accum[z] = 0;
+  }
+  f->sim_ticks = g_prof.sim_ticks;
+  prof_push_event(PROF_ZONE_COUNT, g_prof.last_frame, now, g_prof.sim_ticks);
+  g_prof.sim_ticks = 0;
+  g_prof.last_frame = now;
+  g_prof.head = (g_prof.head + 1) % PROF_HISTORY;
+  if (g_prof.count < PROF_HISTORY) g_prof.count++;
+}
+
+const char *prof_zone_name(ProfZone z) {
+  if (z < 0 || z >= PROF_ZONE_COUNT) return "?";
+  return g_zone_names[z];
+}
+
+/* age 0 is the most recently committed frame. */
+const ProfFrame *prof_frame_at(int age) {
+  if (age < 0 || age >= g_prof.count) return NULL;
+  int idx = (g_prof.head - 1 - age + PROF_HISTORY) % PROF_HISTORY;
+  return &g_prof.frames[idx];
+}
+
+void prof_zone_stats(ProfZone z, float *avg_ms, float *max_ms) {
+  float sum = 0.0f;
+  float mx = 0.0f;
+  for (int i = 0; i < g_prof.count; i++) {
+    float v = g_prof.frames[i].zone_ms[z];
+    sum += v;
+    if (v > mx) mx = v;
+  }
+  *avg_ms = g_prof.count > 0 ? sum / (float)g_prof.count : 0.0f;
+  *max_ms = mx;
+}
+
+void prof_frame_stats(float *avg_ms, float *max_ms) {
+  float sum = 0.0f;
+  float mx = 0.0f;
+  for (int i = 0; i < g_prof.count; i++) {
+    float v = g_prof.frames[i].frame_ms;
+    sum += v;
+    if (v > mx) mx = v;
+  }
+  *avg_ms = g_prof.count > 0 ? sum / (float)g_prof.count : 0.0f;
+  *max_ms = mx;
+}
+
+/* Writes the last PROF_TRACE_SECONDS of spans as Chrome trace-event JSON
+   (chrome://tracing, ui.perfetto.dev). Sim zones go on one thread track,
+   frames and render zones on another. Returns the event count or -1. */
+int prof_write_trace(const char *path) {
+  if (g_prof.event_count == 0) return 0;
+  FILE *f = fopen(path, "w");
+  if (!f) return -1;
+  double us_per_count = g_prof.ms_per_count * 1000.0;
+  int newest = (g_prof.event_head - 1 + PROF_TRACE_EVENTS) % PROF_TRACE_EVENTS;
+  Uint64 cutoff_span = (Uint64)(PROF_TRACE_SECONDS * 1000.0 / g_prof.ms_per_count);
+  Uint64 newest_end = g_prof.events[newest].end;
+  Uint64 cutoff = newest_end > cutoff_span ? newest_end - cutoff_span : 0;
+
+  fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"buh\"}},\n");
+  fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"simulation\"}},\n");
+  fprintf(f, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"render\"}}");
+  int written = 0;
+  int first = (g_prof.event_head - g_prof.event_count + PROF_TRACE_EVENTS) % PROF_TRACE_EVENTS;
+  for (int i = 0; i < g_prof.event_count; i++) {
+    const ProfEvent *ev = &g_prof.events[(first + i) % PROF_TRACE_EVENTS];
+    if (ev->start < cutoff || ev->start < g_prof.origin) continue;
+    double ts = (double)(ev->start - g_prof.origin) * us_per_count;
+    double dur = (double)(ev->end - ev->start) * us_per_count;
+    if (ev->zone == PROF_ZONE_COUNT) {
+      fprintf(f, ",\n{\"name\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":2,\"ts\":%.3f,\"dur\":%.3f,"
+              "\"args\":{\"sim_ticks\":%d}}", ts, dur, ev->ticks);
+    } else {
+      int tid = ev->zone < PROF_RENDER_WORLD ? 1 : 2;
+      fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+              g_zone_names[ev->zone], tid, ts, dur);
+    }
+    written++;
+  }
+  fprintf(f, "\n]}\n");
+  fclose(f);
+  return written;
+}
@@ -0,0 +1,100 @@
+#include "core/scratch.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/game.h"
+
+static int g_guard_depth;
+static int g_guard_hits;
+static int g_guard_fatal = 1;
+
+void scratch_reset(Scratch *s) {
+  for (int i = 0; i < s->spill_count; i++) free(s->spills[i]);
+  s->spill_count = 0;
+  s->arena.used = 0;
+}
+
+/* Uninitialised memory from the block, or from the heap once the block is
+   full. Returns NULL only if the heap fails too or the spill list is full. */
+void *scratch_alloc(Scratch *s, size_t size) {
+  Arena *a = &s->arena;
+  size_t at = (a->used + (ARENA_ALIGN - 1)) & ~(size_t)(ARENA_ALIGN - 1);
+  if (a->base && at + size <= a->size) {
+    a->used = at + size;
+    if (a->used > s->high_water) s->high_water = a->used;
+    return a->base + at;
+  }
+  if (s->spill_count >= SCRATCH_MAX_SPILLS) return NULL;
+  alloc_guard_note("scratch spill");
+  void *p = malloc(size > 0 ? size : 1);
+  if (!p) return NULL;
+  s->spills[s->spill_count++] = p;
+  s->spills_total++;
+  return p;
+}
+
+/* Releases spills; the block itself belongs to whoever carved it. */
+void scratch_free(Scratch *s) {
+  scratch_reset(s);
+  memset(s, 0, sizeof(*s));
+}
+
+void alloc_guard_enter(void) {
+  g_guard_depth++;
+}
+
+void alloc_guard_leave(void) {
+  if (g_guard_depth > 0) g_guard_depth--;
+}
+
+static void guard_hit(const char *what) {
+  if (g_guard_depth == 0) return;
+  if (g_guard_hits++ == 0) log_linef("Heap allocation during a tick: %s", what);
+#ifdef BUH_ALLOC_CHECKS
+  if (g_guard_fatal) assert(!"heap allocation during a tick");
+#endif
+}
+
+/* With wrapped allocators the malloc behind the note is counted instead. */
+void alloc_guard_note(const char *what) {
+#ifndef BUH_ALLOC_WRAP
+  guard_hit(what);
+#else
+  (void)what;
+#endif
+}
+
+int alloc_guard_set_fatal(int fatal) {
+  int prev = g_guard_fatal;
+  g_guard_fatal = fatal;
+  return prev;
+}
+
+int alloc_guard_hits(void) {
+  return g_guard_hits;
+}
+
+#ifdef BUH_ALLOC_WRAP
+/* Linked with --wrap=malloc,--wrap=calloc,--wrap=realloc: every allocation
+   made from our objects lands here first. */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *p, size_t size);
+
+void *__wrap_malloc(size_t size) {
+  guard_hit("malloc");
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t n, size_t size) {
+  guard_hit("calloc");
+  return __real_calloc(n, size);
+}
+
+void *__wrap_realloc(void *p, size_t size) {
+  guard_hit("realloc");
+  return __real_realloc(p, size);
+}
+#endif
@@ -0,0 +1,197 @@
+#include "data/data_pack.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "data/registry.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char *g_pack_sources[DATA_PACK_SECTIONS] = {
+  DATA_WEAPONS_PATH,
+  DATA_ITEMS_PATH,
+  DATA_ENEMIES_PATH,
+  DATA_CHARACTERS_PATH,
+};
+
+/* FNV-1a over the file bytes; 0 means the file could not be read. */
+static uint64_t hash_file(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (!f) return 0;
+  uint64_t h = 1469598103934665603ull;
+  unsigned char buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    for (size_t i = 0; i < n; i++) {
+      h ^= buf[i];
+      h *= 1099511628211ull;
+    }
+  }
+  fclose(f);
+  return h ? h : 1;
+}
+
+typedef struct {
+  const unsigned char *data;
+  size_t size;
+#if defined(_WIN32)
+  HANDLE file;
+  HANDLE mapping;
+#endif
+} MappedFile;
+
+static int map_file(MappedFile *m, const char *path) {
+  memset(m, 0, sizeof(*m));
+#if defined(_WIN32)
+  m->file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (m->file == INVALID_HANDLE_VALUE) return 0;
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(m->file, &size) || size.QuadPart <= 0) {
+    CloseHandle(m->file);
+    return 0;
+  }
+  m->mapping = CreateFileMappingA(m->file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (!m->mapping) {
+    CloseHandle(m->file);
+    return 0;
+  }
+  m->data = (const unsigned char *)MapViewOfFile(m->mapping, FILE_MAP_READ, 0, 0, 0);
+  if (!m->data) {
+    CloseHandle(m->mapping);
+    CloseHandle(m->file);
+    return 0;
+  }
+  m->size = (size_t)size.QuadPart;
+#else
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) return 0;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+    close(fd);
+    return 0;
+  }
+  void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (p == MAP_FAILED) return 0;
+  m->data = (const unsigned char *)p;
+  m->size = (size_t)st.st_size;
+#endif
+  return 1;
+}
+
+static void unmap_file(MappedFile *m) {
+  if (!m->data) return;
+#if defined(_WIN32)
+  UnmapViewOfFile(m->data);
+  CloseHandle(m->mapping);
+  CloseHandle(m->file);
+#else
+  munmap((void *)m->data, m->size);
+#endif
+  m->data = NULL;
+}
+
+static void pack_sections(const Database *db, const void *arrays[DATA_PACK_SECTIONS],
+                          uint32_t sizes[DATA_PACK_SECTIONS], uint32_t counts[DATA_PACK_SECTIONS]) {
+  arrays[0] = db->weapons;
+  sizes[0] = (uint32_t)sizeof(WeaponDef);
+  counts[0] = (uint32_t)db->weapon_count;
+  arrays[1] = db->items;
+  sizes[1] = (uint32_t)sizeof(ItemDef);
+  counts[1] = (uint32_t)db->item_count;
+  arrays[2] = db->enemies;
+  sizes[2] = (uint32_t)sizeof(EnemyDef);
+  counts[2] = (uint32_t)db->enemy_count;
+  arrays[3] = db->characters;
+  sizes[3] = (uint32_t)sizeof(CharacterDef);
+  counts[3] = (uint32_t)db->character_count;
+}
+
+int db_write_pack(const Database *db, const char *path) {
+  const void *arrays[DATA_PACK_SECTIONS];
+  DataPackHeader h;
+  memset(&h, 0, sizeof(h));
+  h.magic = DATA_PACK_MAGIC;
+  h.version = DATA_PACK_VERSION;
+  pack_sections(db, arrays, h.def_size, h.count);
+  uint32_t offset = ((uint32_t)sizeof(h) + 15u) & ~15u;
+  for (int s = 0; s < DATA_PACK_SECTIONS; s++) {
+    h.offset[s] = offset;
+    offset = (offset + h.def_size[s] * h.count[s] + 15u) & ~15u;
+    h.source_hash[s] = hash_file(g_pack_sources[s]);
+  }
+
+  FILE *f = fopen(path, "wb");
+  if (!f) return 0;
+  int ok = fwrite(&h, sizeof(h), 1, f) == 1;
+  for (int s = 0; ok && s < DATA_PACK_SECTIONS; s++) {
+    static const unsigned char zeros[16];
+    long pos = ftell(f);
+    if (pos < (long)h.offset[s]) ok = fwrite(zeros, 1, h.offset[s] - (uint32_t)pos, f) == h.offset[s] - (uint32_t)pos;
+    size_t bytes = (size_t)h.def_size[s] * h.count[s];
+    if (ok && bytes > 0) ok = fwrite(arrays[s], 1, bytes, f) == bytes;
+  }
+  if (fclose(f) != 0) ok = 0;
+  if (!ok) remove(path);
+  return ok;
+}
+
+/* Maps the pack and copies each section into freshly sized Database arrays.
+   Rejects packs from another version/struct layout, truncated files, and
+   (with check_sources) packs older than a JSON file that is still on disk. */
+int db_load_pack(Database *db, const char *path, int check_sources) {
+  MappedFile m;
+  if (!map_file(&m, path)) return 0;
+  int ok = 0;
+  DataPackHeader h;
+  if (m.size >= sizeof(h)) {
+    memcpy(&h, m.data, sizeof(h));
+    ok = h.magic == DATA_PACK_MAGIC && h.version == DATA_PACK_VERSION;
+  }
+
+  const uint32_t sizes[DATA_PACK_SECTIONS] = {
+    (uint32_t)sizeof(WeaponDef), (uint32_t)sizeof(ItemDef), (uint32_t)sizeof(EnemyDef), (uint32_t)sizeof(CharacterDef)};
+  for (int s = 0; ok && s < DATA_PACK_SECTIONS; s++) {
+    if (h.def_size[s] != sizes[s]) ok = 0;
+    else if ((uint64_t)h.offset[s] + (uint64_t)h.def_size[s] * h.count[s] > (uint64_t)m.size) ok = 0;
+    else if (check_sources) {
+      uint64_t current = hash_file(g_pack_sources[s]);
+      if (current != 0 && current != h.source_hash[s]) ok = 0;
+    }
+  }
+  void *arrays[DATA_PACK_SECTIONS] = {NULL, NULL, NULL, NULL};
+  for (int s = 0; ok && s < DATA_PACK_SECTIONS; s++) {
+    size_t bytes = (size_t)h.def_size[s] * h.count[s];
+    arrays[s] = malloc(bytes > 0 ? bytes : 1);
+    if (!arrays[s]) ok = 0;
+    else memcpy(arrays[s], m.data + h.offset[s], bytes);
+  }
+  if (ok) {
+    free(db->weapons);
+    free(db->items);
+    free(db->enemies);
+    free(db->characters);
+    db->weapons = (WeaponDef *)arrays[0];
+    db->items = (ItemDef *)arrays[1];
+    db->enemies = (EnemyDef *)arrays[2];
+    db->characters = (CharacterDef *)arrays[3];
+    db->weapon_count = (int)h.count[0];
+    db->item_count = (int)h.count[1];
+    db->enemy_count = (int)h.count[2];
+    db->character_count = (int)h.count[3];
+    db->from_pack = 1;
+    db_build_index(db);
+  } else {
+    for (int s = 0; s < DATA_PACK_SECTIONS; s++) free(arrays[s]);
+  }
+  unmap_file(&m);
+  return ok;
+}
@@ -0,0 +1,233 @@
+#include "data/hot_reload.h"
+
+#include <sys/stat.h>
+
+#include "data/registry.h"
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#define HOT_RELOAD_DIR "data"
+#define HOT_RELOAD_SETTLE_MS 150 /* editors often write a file in several steps */
+#define HOT_RELOAD_POLL_MS 1000  /* mtime polling when no watcher is available */
+
+static const char *g_reload_paths[HOT_RELOAD_FILES] = {
+  DATA_WEAPONS_PATH,
+  DATA_ITEMS_PATH,
+  DATA_ENEMIES_PATH,
+  DATA_CHARACTERS_PATH,
+};
+
+static void file_stamp(const char *path, long long *mtime, long long *size) {
+  struct stat st;
+  if (stat(path, &st) != 0) {
+    *mtime = 0;
+    *size = 0;
+    return;
+  }
+  *mtime = (long long)st.st_mtime;
+  *size = (long long)st.st_size;
+}
+
+int hot_reload_init(HotReload *hr) {
+  memset(hr, 0, sizeof(*hr));
+  hr->inotify_fd = -1;
+  for (int i = 0; i < HOT_RELOAD_FILES; i++) file_stamp(g_reload_paths[i], &hr->mtime[i], &hr->size[i]);
+#if defined(_WIN32)
+  HANDLE h = FindFirstChangeNotificationA(HOT_RELOAD_DIR, FALSE,
+                                          FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+  if (h != INVALID_HANDLE_VALUE) hr->change_handle = h;
+#elif defined(__linux__)
+  hr->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (hr->inotify_fd >= 0 && inotify_add_watch(hr->inotify_fd, HOT_RELOAD_DIR, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+    close(hr->inotify_fd);
+    hr->inotify_fd = -1;
+  }
+#endif
+  hr->active = 1;
+  int watching = hr->change_handle != NULL || hr->inotify_fd >= 0;
+  log_linef("Hot reload: %s %s/", watching ? "watching" : "polling", HOT_RELOAD_DIR);
+  return watching;
+}
+
+void hot_reload_close(HotReload *hr) {
+#if defined(_WIN32)
+  if (hr->change_handle) FindCloseChangeNotification((HANDLE)hr->change_handle);
+#elif defined(__linux__)
+  if (hr->inotify_fd >= 0) close(hr->inotify_fd);
+#endif
+  memset(hr, 0, sizeof(*hr));
+  hr->inotify_fd = -1;
+}
+
+/* Drains the OS watcher; returns 1 if anything in data/ changed. */
+static int watcher_signaled(HotReload *hr, Uint32 now) {
+#if defined(_WIN32)
+  if (hr->change_handle) {
+    if (WaitForSingleObject((HANDLE)hr->change_handle, 0) != WAIT_OBJECT_0) return 0;
+    FindNextChangeNotification((HANDLE)hr->change_handle);
+    return 1;
+  }
+#elif defined(__linux__)
+  if (hr->inotify_fd >= 0) {
+    char buf[4096];
+    int any = 0;
+    while (read(hr->inotify_fd, buf, sizeof(buf)) > 0) any = 1;
+    return any;
+  }
+#endif
+  if (now - hr->last_poll < HOT_RELOAD_POLL_MS) return 0;
+  hr->last_poll = now;
+  return 1;
+}
+
+static int remap_weapon(const Database *old, Database *next, int idx) {
+  if (idx < 0 || idx >= old->weapon_count) return -1;
+  return find_weapon(next, old->weapons[idx].id);
+}
+
+static int remap_item(const Database *old, Database *next, int idx) {
+  if (idx < 0 || idx >= old->item_count) return -1;
+  return find_item(next, old->items[idx].id);
+}
+
+static int remap_enemy(const Database *old, Database *next, int idx) {
+  if (idx < 0 || idx >= old->enemy_count) return -1;
+  return find_enemy(next, old->enemies[idx].id);
+}
+
+static int remap_character(const Database *old, Database *next, int idx) {
+  if (idx < 0 || idx >= old->character_count) return -1;
+  return find_character(next, old->characters[idx].id);
+}
+
+/* Content removed from the JSON disappears from the run rather than pointing
+   at whatever now occupies its old index. */
+static void remap_player(const Database *old, Database *next, Player *p) {
+  for (int i = 0; i < MAX_WEAPON_SLOTS; i++) {
+    if (!p->weapons[i].active) continue;
+    p->weapons[i].def_index = remap_weapon(old, next, p->weapons[i].def_index);
+    if (p->weapons[i].def_index < 0) p->weapons[i].active = 0;
+  }
+  int kept = 0;
+  for (int i = 0; i < p->passive_count && i < MAX_PASSIVE_ITEMS; i++) {
+    int idx = remap_item(old, next, p->passive_items[i]);
+    if (idx >= 0) p->passive_items[kept++] = idx;
+  }
+  p->passive_count = kept;
+}
+
+static void remap_enemies(const Database *old, Database *next, Enemy *enemies, int count) {
+  for (int i = 0; i < count; i++) {
+    if (!enemies[i].active) continue;
+    enemies[i].def_index = remap_enemy(old, next, enemies[i].def_index);
+    if (enemies[i].def_index < 0) enemies[i].active = 0;
+  }
+}
+
+static void remap_bullets(const Database *old, Database *next, Bullet *bullets, int count) {
+  for (int i = 0; i < count; i++) {
+    if (bullets[i].active && bullets[i].weapon_index >= 0)
+      bullets[i].weapon_index = remap_weapon(old, next, bullets[i].weapon_index);
+  }
+}
+
+/* Moves every index the game holds into next by id, then installs next as
+   g->db, taking ownership of its arrays and freeing the old ones. Must run
+   between ticks. Returns 1 on success; on failure next is left untouched. */
+int game_swap_database(Game *g, Database *next) {
+  const Database *old = &g->db;
+  if (next->weapon_count == 0 || next->enemy_count == 0 || next->character_count == 0) return 0;
+
+  remap_player(old, next, &g->player);
+  remap_enemies(old, next, g->enemies, g->caps.enemies);
+  remap_bullets(old, next, g->bullets, g->caps.bullets);
+  if (g->wave_snapshot.valid) {
+    remap_player(old, next, &g->wave_snapshot.player);
+    remap_enemies(old, next, g->wave_snapshot.enemies, g->caps.enemies);
+    remap_bullets(old, next, g->wave_snapshot.bullets, g->caps.bullets);
+    g->wave_snapshot.last_item_index = remap_item(old, next, g->wave_snapshot.last_item_index);
+  }
+  g->last_item_index = remap_item(old, next, g->last_item_index);
+  if (g->selected_character >= 0) g->selected_character = remap_character(old, next, g->selected_character);
+
+  /* Offered choices point at defs too; drop any that no longer resolve. */
+  int kept = 0;
+  for (int i = 0; i < g->choice_count; i++) {
+    LevelUpChoice c = g->choices[i];
+    if (g->mode == MODE_START) c.index = remap_character(old, next, c.index);
+    else if (c.type == 0) c.index = remap_item(old, next, c.index);
+    else c.index = remap_weapon(old, next, c.index);
+    if (c.index >= 0) g->choices[kept++] = c;
+  }
+  if (kept != g->choice_count) g->levelup_selected_count = 0;
+  g->choice_count = kept;
+
+  db_free(&g->db);
+  g->db = *next;
+  memset(next, 0, sizeof(*next));
+  game_assets_bind_characters(g);
+  return 1;
+}
+
+/* Call once per frame before the simulation ticks. Returns 1 if a new
+   Database was swapped in. */
+int hot_reload_poll(HotReload *hr, Game *g) {
+  if (!hr->active) return 0;
+  Uint32 now = SDL_GetTicks();
+  if (watcher_signaled(hr, now)) {
+    hr->pending = 1;
+    hr->pending_since = now;
+  }
+  if (!hr->pending || now - hr->pending_since < HOT_RELOAD_SETTLE_MS) return 0;
+  hr->pending = 0;
+
+  int changed[HOT_RELOAD_FILES];
+  int any = 0;
+  for (int i = 0; i < HOT_RELOAD_FILES; i++) {
+    long long mtime = 0;
+    long long size = 0;
+    file_stamp(g_reload_paths[i], &mtime, &size);
+    changed[i] = mtime != hr->mtime[i] || size != hr->size[i];
+    if (changed[i]) {
+      hr->mtime[i] = mtime;
+      hr->size[i] = size;
+      any = 1;
+    }
+  }
+  if (!any) return 0;
+
+  Uint64 t0 = SDL_GetPerformanceCounter();
+  Database *next = (Database *)malloc(sizeof(Database));
+  if (!next) return 0;
+  if (!db_copy(next, &g->db)) {
+    free(next);
+    return 0;
+  }
+  int ok = 1;
+  for (int i = 0; i < HOT_RELOAD_FILES && ok; i++) {
+    if (!changed[i]) continue;
+    if (!db_load_json_file(next, g_reload_paths[i])) {
+      log_linef("Hot reload: %s failed to parse, keeping current data", g_reload_paths[i]);
+      ok = 0;
+    }
+  }
+  if (ok && !game_swap_database(g, next)) {
+    log_line("Hot reload: reloaded data is missing weapons, enemies or characters, keeping current data");
+    ok = 0;
+  }
+  db_free(next);
+  free(next);
+  if (!ok) return 0;
+
+  hr->reloads++;
+  double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+  for (int i = 0; i < HOT_RELOAD_FILES; i++) {
+    if (changed[i]) log_linef("Hot reload: %s", g_reload_paths[i]);
+  }
+  log_linef("Hot reload #%d applied in %.2f ms (weapons=%d items=%d enemies=%d characters=%d)", hr->reloads, ms,
+            g->db.weapon_count, g->db.item_count, g->db.enemy_count, g->db.character_count);
+  return 1;
+}
@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "core/config.h"
+#include "data/data_pack.h"
 
 #define JSMN_PARENT_LINKS
 #include "jsmn/jsmn.h"
@@ -26,6 +27,22 @@ static char *read_file(const char *path) {
   return buf;
 }
 
+/* Every token spans at least one character plus a separator, so len / 2 + 2
+   tokens always suffice; content growth never hits a fixed token cap. */
+static jsmntok_t *parse_tokens(const char *json) {
+  jsmn_parser parser;
+  size_t len = strlen(json);
+  size_t cap = len / 2 + 2;
+  jsmntok_t *tokens = (jsmntok_t *)malloc(sizeof(jsmntok_t) * cap);
+  if (!tokens) return NULL;
+  jsmn_init(&parser);
+  if (jsmn_parse(&parser, json, len, tokens, (unsigned int)cap) < 0) {
+    free(tokens);
+    return NULL;
+  }
+  return tokens;
+}
+
 static int jsoneq(const char *json, jsmntok_t *tok, const char *s) {
   if (tok->type == JSMN_STRING && (int)strlen(s) == tok->end - tok->start &&
       strncmp(json + tok->start, s, tok->end - tok->start) == 0) {
@@ -89,6 +106,12 @@ static int token_int(const char *json, jsmntok_t *tok) {
   return (int)token_float(json, tok);
 }
 
+/* Replaces a def array with a zeroed one sized for n entries. */
+static void *alloc_defs(void *old, int n, size_t size) {
+  free(old);
+  return calloc((size_t)(n > 0 ? n : 1), size);
+}
+
 static void parse_stats_object(const char *json, jsmntok_t *t, int obj, Stats *out) {
   memset(out, 0, sizeof(*out));
   if (obj < 0 || t[obj].type != JSMN_OBJECT) return;
@@ -115,23 +138,27 @@ static void parse_stats_object(const char *json, jsmntok_t *t, int obj, Stats *o
 static int load_weapons(Database *db, const char *path) {
   char *json = read_file(path);
   if (!json) return 0;
-  jsmn_parser parser;
-  jsmn_init(&parser);
-  jsmntok_t tokens[1024];
-  int count = jsmn_parse(&parser, json, strlen(json), tokens, 1024);
-  if (count < 0) {
+  jsmntok_t *tokens = parse_tokens(json);
+  if (!tokens) {
     free(json);
     return 0;
   }
   int arr = find_key(json, tokens, 0, "weapons");
   if (arr < 0 || tokens[arr].type != JSMN_ARRAY) {
+    free(tokens);
     free(json);
     return 0;
   }
   int idx = arr + 1;
   int n = tokens[arr].size;
   db->weapon_count = 0;
-  for (int i = 0; i < n && db->weapon_count < MAX_WEAPONS; i++) {
+  db->weapons = (WeaponDef *)alloc_defs(db->weapons, n, sizeof(WeaponDef));
+  if (!db->weapons) {
+    free(tokens);
+    free(json);
+    return 0;
+  }
+  for (int i = 0; i < n; i++) {
     int obj = idx;
     WeaponDef *w = &db->weapons[db->weapon_count++];
     memset(w, 0, sizeof(*w));
@@ -175,6 +202,7 @@ static int load_weapons(Database *db, const char *path) {
     }
     idx += token_span(tokens, idx);
   }
+  free(tokens);
   free(json);
   return 1;
 }
@@ -182,23 +210,27 @@ static int load_weapons(Database *db, const char *path) {
 static int load_items(Database *db, const char *path) {
   char *json = read_file(path);
   if (!json) return 0;
-  jsmn_parser parser;
-  jsmn_init(&parser);
-  jsmntok_t tokens[2048];
-  int count = jsmn_parse(&parser, json, strlen(json), tokens, 2048);
-  if (count < 0) {
+  jsmntok_t *tokens = parse_tokens(json);
+  if (!tokens) {
     free(json);
     return 0;
   }
   int arr = find_key(json, tokens, 0, "items");
   if (arr < 0 || tokens[arr].type != JSMN_ARRAY) {
+    free(tokens);
     free(json);
     return 0;
   }
   int idx = arr + 1;
   int n = tokens[arr].size;
   db->item_count = 0;
-  for (int i = 0; i < n && db->item_count < MAX_ITEMS; i++) {
+  db->items = (ItemDef *)alloc_defs(db->items, n, sizeof(ItemDef));
+  if (!db->items) {
+    free(tokens);
+    free(json);
+    return 0;
+  }
+  for (int i = 0; i < n; i++) {
     int obj = idx;
     ItemDef *it = &db->items[db->item_count++];
     memset(it, 0, sizeof(*it));
@@ -262,6 +294,7 @@ static int load_items(Database *db, const char *path) {
 
     idx += token_span(tokens, idx); 
   } 
+  free(tokens);
   free(json);
   return 1;
 }
@@ -269,23 +302,27 @@ static int load_items(Database *db, const char *path) {
 static int load_enemies(Database *db, const char *path) {
   char *json = read_file(path);
   if (!json) return 0;
-  jsmn_parser parser;
-  jsmn_init(&parser);
-  jsmntok_t tokens[2048];
-  int count = jsmn_parse(&parser, json, strlen(json), tokens, 2048);
-  if (count < 0) {
+  jsmntok_t *tokens = parse_tokens(json);
+  if (!tokens) {
     free(json);
     return 0;
   }
   int arr = find_key(json, tokens, 0, "enemies");
   if (arr < 0 || tokens[arr].type != JSMN_ARRAY) {
+    free(tokens);
     free(json);
     return 0;
   }
   int idx = arr + 1;
   int n = tokens[arr].size;
   db->enemy_count = 0;
-  for (int i = 0; i < n && db->enemy_count < MAX_ITEMS; i++) {
+  db->enemies = (EnemyDef *)alloc_defs(db->enemies, n, sizeof(EnemyDef));
+  if (!db->enemies) {
+    free(tokens);
+    free(json);
+    return 0;
+  }
+  for (int i = 0; i < n; i++) {
     int obj = idx;
     EnemyDef *e = &db->enemies[db->enemy_count++];
     memset(e, 0, sizeof(*e));
@@ -316,6 +353,7 @@ static int load_enemies(Database *db, const char *path) {
 
     idx += token_span(tokens, idx);
   }
+  free(tokens);
   free(json);
   return 1;
 }
@@ -323,23 +361,27 @@ static int load_enemies(Database *db, const char *path) {
 static int load_characters(Database *db, const char *path) {
   char *json = read_file(path);
   if (!json) return 0;
-  jsmn_parser parser;
-  jsmn_init(&parser);
-  jsmntok_t tokens[1024];
-  int count = jsmn_parse(&parser, json, strlen(json), tokens, 1024);
-  if (count < 0) {
+  jsmntok_t *tokens = parse_tokens(json);
+  if (!tokens) {
     free(json);
     return 0;
   }
   int arr = find_key(json, tokens, 0, "characters");
   if (arr < 0 || tokens[arr].type != JSMN_ARRAY) {
+    free(tokens);
     free(json);
     return 0;
   }
   int idx = arr + 1;
   int n = tokens[arr].size;
   db->character_count = 0;
-  for (int i = 0; i < n && db->character_count < MAX_CHARACTERS; i++) {
+  db->characters = (CharacterDef *)alloc_defs(db->characters, n, sizeof(CharacterDef));
+  if (!db->characters) {
+    free(tokens);
+    free(json);
+    return 0;
+  }
+  for (int i = 0; i < n; i++) {
     int obj = idx;
     CharacterDef *c = &db->characters[db->character_count++];
     memset(c, 0, sizeof(*c));
@@ -369,21 +411,265 @@ static int load_characters(Database *db, const char *path) {
     if (stats > 0) parse_stats_object(json, tokens, stats, &c->stats);
     idx += token_span(tokens, idx);
   }
+  free(tokens);
   free(json);
   return 1;
 }
 
-int db_load(Database *db) {
-  if (!load_weapons(db, "data/weapons.json")) return 0;
-  if (!load_items(db, "data/items.json")) return 0;
-  if (!load_enemies(db, "data/enemies.json")) return 0;
-  if (!load_characters(db, "data/characters.json")) return 0;
+static int token_bool(const char *json, jsmntok_t *tok) {
+  return tok->type == JSMN_PRIMITIVE && json[tok->start] == 't';
+}
+
+int load_asset_manifest(const char *path, AssetManifestEntry *out, int max, int *count) {
+  *count = 0;
+  char *json = read_file(path);
+  if (!json) return 0;
+  jsmntok_t *tokens = parse_tokens(json);
+  if (!tokens) {
+    free(json);
+    return 0;
+  }
+  int arr = find_key(json, tokens, 0, "assets");
+  if (arr < 0 || tokens[arr].type != JSMN_ARRAY) {
+    free(tokens);
+    free(json);
+    return 0;
+  }
+  int idx = arr + 1;
+  int n = tokens[arr].size;
+  for (int i = 0; i < n && *count < max; i++) {
+    int obj = idx;
+    idx += token_span(tokens, idx);
+    int idt = find_key(json, tokens, obj, "id");
+    int pt = find_key(json, tokens, obj, "path");
+    if (idt < 0 || pt < 0) continue;
+    AssetManifestEntry *a = &out[(*count)++];
+    memset(a, 0, sizeof(*a));
+    token_string(json, &tokens[idt], a->id, (int)sizeof(a->id));
+    token_string(json, &tokens[pt], a->path, (int)sizeof(a->path));
+    int pre = find_key(json, tokens, obj, "preload");
+    int fb = find_key(json, tokens, obj, "fallback");
+    a->preload = pre > 0 ? token_bool(json, &tokens[pre]) : 1;
+    a->fallback = fb > 0 ? token_bool(json, &tokens[fb]) : 0;
+  }
+  free(tokens);
+  free(json);
   return 1;
 }
 
-int find_weapon(Database *db, const char *id) {
-  for (int i = 0; i < db->weapon_count; i++) {
-    if (strcmp(db->weapons[i].id, id) == 0) return i;
+static unsigned int spawn_pattern_bit(const char *name) {
+  if (strcmp(name, "edge") == 0) return SPAWN_EDGE;
+  if (strcmp(name, "ring") == 0) return SPAWN_RING;
+  if (strcmp(name, "swarm") == 0) return SPAWN_SWARM;
+  if (strcmp(name, "line") == 0) return SPAWN_LINE;
+  return 0;
+}
+
+/* Reads the director's difficulty curve; phases must be listed by start time. */
+int load_spawn_curve(const char *path, SpawnPhase *out, int max, int *count) {
+  *count = 0;
+  char *json = read_file(path);
+  if (!json) return 0;
+  jsmntok_t *tokens = parse_tokens(json);
+  if (!tokens) {
+    free(json);
+    return 0;
+  }
+  int arr = find_key(json, tokens, 0, "phases");
+  if (arr < 0 || tokens[arr].type != JSMN_ARRAY) {
+    free(tokens);
+    free(json);
+    return 0;
+  }
+  int idx = arr + 1;
+  int n = tokens[arr].size;
+  for (int i = 0; i < n && *count < max; i++) {
+    int obj = idx;
+    idx += token_span(tokens, idx);
+    SpawnPhase *ph = &out[(*count)++];
+    memset(ph, 0, sizeof(*ph));
+    ph->interval = 1.0f;
+    ph->batch = 1;
+    int st = find_key(json, tokens, obj, "start");
+    int it = find_key(json, tokens, obj, "interval");
+    int bt = find_key(json, tokens, obj, "batch");
+    if (st > 0) ph->start = token_float(json, &tokens[st]);
+    if (it > 0) ph->interval = token_float(json, &tokens[it]);
+    if (bt > 0) ph->batch = token_int(json, &tokens[bt]);
+
+    int pt = find_key(json, tokens, obj, "patterns");
+    if (pt > 0 && tokens[pt].type == JSMN_ARRAY) {
+      for (int k = 0; k < tokens[pt].size; k++) {
+        char name[16];
+        token_string(json, &tokens[pt + 1 + k], name, (int)sizeof(name));
+        ph->patterns |= spawn_pattern_bit(name);
+      }
+    }
+    if (ph->patterns == 0) ph->patterns = SPAWN_EDGE;
+
+    int et = find_key(json, tokens, obj, "enemies");
+    if (et > 0 && tokens[et].type == JSMN_ARRAY) {
+      for (int k = 0; k < tokens[et].size && ph->enemy_count < MAX_SPAWN_PHASE_ENEMIES; k++) {
+        token_string(json, &tokens[et + 1 + k], ph->enemies[ph->enemy_count], (int)sizeof(ph->enemies[0]));
+        ph->enemy_count++;
+      }
+    }
+  }
+  free(tokens);
+  free(json);
+  return 1;
+}
+
+int db_load_json(Database *db) {
+  db->from_pack = 0;
+  if (!load_weapons(db, DATA_WEAPONS_PATH)) return 0;
+  if (!load_items(db, DATA_ITEMS_PATH)) return 0;
+  if (!load_enemies(db, DATA_ENEMIES_PATH)) return 0;
+  if (!load_characters(db, DATA_CHARACTERS_PATH)) return 0;
+  db_build_index(db);
+  return 1;
+}
+
+/* Re-parses one content file into db, leaving the other sections as they are. */
+int db_load_json_file(Database *db, const char *path) {
+  int ok = 0;
+  db->from_pack = 0;
+  if (strcmp(path, DATA_WEAPONS_PATH) == 0) ok = load_weapons(db, path);
+  else if (strcmp(path, DATA_ITEMS_PATH) == 0) ok = load_items(db, path);
+  else if (strcmp(path, DATA_ENEMIES_PATH) == 0) ok = load_enemies(db, path);
+  else if (strcmp(path, DATA_CHARACTERS_PATH) == 0) ok = load_characters(db, path);
+  if (ok) db_build_index(db);
+  return ok;
+}
+
+/* Prefers the compiled pack; any JSON edited since the pack was built wins. */
+int db_load(Database *db) {
+  if (db_load_pack(db, DATA_PACK_PATH, 1)) return 1;
+  return db_load_json(db);
+}
+
+static unsigned int id_hash(const char *id) {
+  unsigned int h = 2166136261u;
+  while (*id) {
+    h ^= (unsigned char)*id++;
+    h *= 16777619u;
+  }
+  return h;
+}
+
+/* Every def struct starts with its char id[32]; stride walks the array. */
+static const char *def_id(const void *defs, size_t stride, int i) {
+  return (const char *)defs + stride * (size_t)i;
+}
+
+static void id_index_build(IdIndex *ix, const void *defs, size_t stride, int count) {
+  int cap = 16;
+  while (cap < count * 2) cap *= 2;
+  if (cap != ix->cap) {
+    free(ix->slots);
+    ix->slots = (IdSlot *)malloc(sizeof(IdSlot) * (size_t)cap);
+    ix->cap = ix->slots ? cap : 0;
+  }
+  for (int i = 0; i < ix->cap; i++) ix->slots[i].index = -1;
+  for (int i = 0; i < count && ix->cap > 0; i++) {
+    const char *id = def_id(defs, stride, i);
+    unsigned int h = id_hash(id);
+    int mask = ix->cap - 1;
+    int slot = (int)(h & (unsigned int)mask);
+    int dup = 0;
+    while (ix->slots[slot].index >= 0) {
+      /* First definition wins, matching the old linear scan. */
+      if (ix->slots[slot].hash == h && strcmp(def_id(defs, stride, ix->slots[slot].index), id) == 0) {
+        dup = 1;
+        break;
+      }
+      slot = (slot + 1) & mask;
+    }
+    if (dup) continue;
+    ix->slots[slot].hash = h;
+    ix->slots[slot].index = i;
+  }
+}
+
+/* Falls back to a scan for hand-built databases that never had an index. */
+static int id_index_find(const IdIndex *ix, const void *defs, size_t stride, int count, const char *id) {
+  if (!id) return -1;
+  if (ix->cap == 0) {
+    for (int i = 0; i < count; i++) {
+      if (strcmp(def_id(defs, stride, i), id) == 0) return i;
+    }
+    return -1;
+  }
+  unsigned int h = id_hash(id);
+  int mask = ix->cap - 1;
+  for (int slot = (int)(h & (unsigned int)mask); ix->slots[slot].index >= 0; slot = (slot + 1) & mask) {
+    const IdSlot *e = &ix->slots[slot];
+    if (e->hash == h && strcmp(def_id(defs, stride, e->index), id) == 0) return e->index;
   }
   return -1;
 }
+
+/* Rebuilds every id index and re-resolves the well-known defs. Loaders call
+   this; code that edits def arrays directly must call it again. */
+void db_build_index(Database *db) {
+  id_index_build(&db->weapon_ids, db->weapons, sizeof(WeaponDef), db->weapon_count);
+  id_index_build(&db->item_ids, db->items, sizeof(ItemDef), db->item_count);
+  id_index_build(&db->enemy_ids, db->enemies, sizeof(EnemyDef), db->enemy_count);
+  id_index_build(&db->character_ids, db->characters, sizeof(CharacterDef), db->character_count);
+  db->enemy_eye = find_enemy(db, "eye");
+  db->enemy_ghost = find_enemy(db, "ghost");
+}
+
+static void *dup_defs(const void *src, int count, size_t size) {
+  void *out = calloc((size_t)(count > 0 ? count : 1), size);
+  if (out && count > 0) memcpy(out, src, size * (size_t)count);
+  return out;
+}
+
+/* Deep copy into an empty dst; returns 0 (leaving dst empty) if out of memory. */
+int db_copy(Database *dst, const Database *src) {
+  memset(dst, 0, sizeof(*dst));
+  dst->weapons = (WeaponDef *)dup_defs(src->weapons, src->weapon_count, sizeof(WeaponDef));
+  dst->items = (ItemDef *)dup_defs(src->items, src->item_count, sizeof(ItemDef));
+  dst->enemies = (EnemyDef *)dup_defs(src->enemies, src->enemy_count, sizeof(EnemyDef));
+  dst->characters = (CharacterDef *)dup_defs(src->characters, src->character_count, sizeof(CharacterDef));
+  if (!dst->weapons || !dst->items || !dst->enemies || !dst->characters) {
+    db_free(dst);
+    return 0;
+  }
+  dst->weapon_count = src->weapon_count;
+  dst->item_count = src->item_count;
+  dst->enemy_count = src->enemy_count;
+  dst->character_count = src->character_count;
+  dst->from_pack = src->from_pack;
+  db_build_index(dst);
+  return 1;
+}
+
+void db_free(Database *db) {
+  free(db->weapons);
+  free(db->items);
+  free(db->enemies);
+  free(db->characters);
+  free(db->weapon_ids.slots);
+  free(db->item_ids.slots);
+  free(db->enemy_ids.slots);
+  free(db->character_ids.slots);
+  memset(db, 0, sizeof(*db));
+}
+
+int find_weapon(Database *db, const char *id) {
+  return id_index_find(&db->weapon_ids, db->weapons, sizeof(WeaponDef), db->weapon_count, id);
+}
+
+int find_item(Database *db, const char *id) {
+  return id_index_find(&db->item_ids, db->items, sizeof(ItemDef), db->item_count, id);
+}
+
+int find_enemy(Database *db, const char *id) {
+  return id_index_find(&db->enemy_ids, db->enemies, sizeof(EnemyDef), db->enemy_count, id);
+}
+
+int find_character(Database *db, const char *id) {
+  return id_index_find(&db->character_ids, db->characters, sizeof(CharacterDef), db->character_count, id);
+}
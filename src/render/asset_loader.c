@@ -0,0 +1,113 @@
+#include "render/asset_loader.h"
+
+#include "core/game.h"
+
+#define ASSET_MAX_WORKERS 8
+
+void asset_batch_init(AssetBatch *b) {
+  memset(b, 0, sizeof(*b));
+}
+
+void asset_batch_add(AssetBatch *b, const char *path, SDL_Texture **out, int fallback) {
+  if (b->count == b->cap) {
+    int cap = b->cap ? b->cap * 2 : 64;
+    AssetRequest *items = (AssetRequest *)realloc(b->items, sizeof(AssetRequest) * (size_t)cap);
+    if (!items) {
+      log_linef("Asset queue full, skipping %s", path);
+      *out = NULL;
+      return;
+    }
+    b->items = items;
+    b->cap = cap;
+  }
+  AssetRequest *req = &b->items[b->count++];
+  memset(req, 0, sizeof(*req));
+  snprintf(req->path, sizeof(req->path), "%s", path);
+  req->out = out;
+  req->fallback = fallback;
+  *out = NULL;
+}
+
+static void decode_request(AssetRequest *req) {
+  Uint64 t0 = SDL_GetPerformanceCounter();
+  req->surface = IMG_Load(req->path);
+  if (!req->surface && req->fallback) {
+    char alt[192];
+    snprintf(alt, sizeof(alt), "../%s", req->path);
+    req->surface = IMG_Load(alt);
+    if (!req->surface) {
+      snprintf(alt, sizeof(alt), "../../%s", req->path);
+      req->surface = IMG_Load(alt);
+    }
+  }
+  if (!req->surface) snprintf(req->error, sizeof(req->error), "%s", IMG_GetError());
+  req->decode_ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+  SDL_AtomicSet(&req->done, 1);
+}
+
+static int asset_worker(void *data) {
+  AssetBatch *b = (AssetBatch *)data;
+  for (;;) {
+    int i = SDL_AtomicAdd(&b->next, 1);
+    if (i >= b->count) break;
+    decode_request(&b->items[i]);
+  }
+  return 0;
+}
+
+/* Decodes every queued image on a worker pool while this (render) thread
+   uploads finished surfaces in queue order. Returns the number loaded. */
+int asset_batch_load(AssetBatch *b, SDL_Renderer *r) {
+  if (b->count == 0) return 0;
+  Uint64 t0 = SDL_GetPerformanceCounter();
+  double freq = (double)SDL_GetPerformanceFrequency();
+  SDL_AtomicSet(&b->next, 0);
+
+  int workers = SDL_GetCPUCount() - 1;
+  if (workers < 1) workers = 1;
+  if (workers > ASSET_MAX_WORKERS) workers = ASSET_MAX_WORKERS;
+  if (workers > b->count) workers = b->count;
+  SDL_Thread *threads[ASSET_MAX_WORKERS];
+  int started = 0;
+  for (int i = 0; i < workers; i++) {
+    threads[started] = SDL_CreateThread(asset_worker, "asset_decode", b);
+    if (threads[started]) started++;
+  }
+  /* No threads: decode inline so loading still works. */
+  if (started == 0) asset_worker(b);
+
+  int loaded = 0;
+  double decode_total = 0.0;
+  for (int i = 0; i < b->count; i++) {
+    AssetRequest *req = &b->items[i];
+    while (!SDL_AtomicGet(&req->done)) SDL_Delay(1);
+    decode_total += req->decode_ms;
+    if (!req->surface) {
+      log_linef("Failed to load %s: %s", req->path, req->error);
+      continue;
+    }
+    Uint64 u0 = SDL_GetPerformanceCounter();
+    *req->out = SDL_CreateTextureFromSurface(r, req->surface);
+    double upload_ms = (double)(SDL_GetPerformanceCounter() - u0) * 1000.0 / freq;
+    if (*req->out) {
+      loaded++;
+      log_linef("Loaded %s (%dx%d, decode %.2f ms, upload %.2f ms)", req->path, req->surface->w, req->surface->h,
+                req->decode_ms, upload_ms);
+    } else {
+      log_linef("Failed to upload %s: %s", req->path, SDL_GetError());
+    }
+    SDL_FreeSurface(req->surface);
+    req->surface = NULL;
+  }
+  for (int i = 0; i < started; i++) SDL_WaitThread(threads[i], NULL);
+
+  double wall_ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / freq;
+  log_linef("Assets: %d/%d loaded in %.1f ms on %d workers (decode sum %.1f ms)", loaded, b->count, wall_ms,
+            started > 0 ? started : 1, decode_total);
+  return loaded;
+}
+
+void asset_batch_free(AssetBatch *b) {
+  free(b->items);
+  memset(b, 0, sizeof(*b));
+}
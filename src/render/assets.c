@@ -0,0 +1,120 @@
+#include "render/assets.h"
+
+#include "core/game.h"
+#include "render/asset_loader.h"
+
+void assets_init(AssetRegistry *a, SDL_Renderer *r) {
+  memset(a, 0, sizeof(*a));
+  a->renderer = r;
+}
+
+/* Re-registering an id updates its path/flags and keeps the handle stable. */
+AssetHandle assets_register(AssetRegistry *a, const char *id, const char *path, int preload, int fallback) {
+  AssetHandle h = assets_find(a, id);
+  if (h == ASSET_NONE) {
+    if (a->count >= MAX_ASSETS) {
+      log_linef("Asset registry full, skipping %s", id);
+      return ASSET_NONE;
+    }
+    h = a->count++;
+    memset(&a->entries[h], 0, sizeof(a->entries[h]));
+    snprintf(a->entries[h].id, sizeof(a->entries[h].id), "%s", id);
+  }
+  AssetEntry *e = &a->entries[h];
+  if (strcmp(e->path, path) != 0) {
+    if (e->tex) SDL_DestroyTexture(e->tex);
+    e->tex = NULL;
+    e->failed = 0;
+    snprintf(e->path, sizeof(e->path), "%s", path);
+  }
+  e->preload = preload;
+  e->fallback = fallback;
+  return h;
+}
+
+AssetHandle assets_find(const AssetRegistry *a, const char *id) {
+  for (int i = 0; i < a->count; i++) {
+    if (strcmp(a->entries[i].id, id) == 0) return i;
+  }
+  return ASSET_NONE;
+}
+
+/* Loads on first use. Returns NULL for unknown handles, failed loads, or when
+   there is no renderer (headless tools and tests). */
+SDL_Texture *assets_get(AssetRegistry *a, AssetHandle h) {
+  if (h < 0 || h >= a->count) return NULL;
+  AssetEntry *e = &a->entries[h];
+  if (e->tex || e->failed || !a->renderer) return e->tex;
+  Uint64 t0 = SDL_GetPerformanceCounter();
+  e->tex = e->fallback ? load_texture_fallback(a->renderer, e->path) : IMG_LoadTexture(a->renderer, e->path);
+  double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+  if (e->tex) {
+    log_linef("Lazy-loaded %s (%s, %.2f ms)", e->id, e->path, ms);
+  } else {
+    e->failed = 1;
+    log_linef("Failed to load %s: %s", e->path, IMG_GetError());
+  }
+  return e->tex;
+}
+
+void assets_acquire(AssetRegistry *a, AssetHandle h) {
+  if (h < 0 || h >= a->count) return;
+  a->entries[h].refcount++;
+}
+
+void assets_release(AssetRegistry *a, AssetHandle h) {
+  if (h < 0 || h >= a->count) return;
+  if (a->entries[h].refcount > 0) a->entries[h].refcount--;
+}
+
+/* Decodes every preload or currently referenced entry that isn't resident yet
+   on the asset_loader worker pool. Returns the number of textures uploaded. */
+int assets_prefetch(AssetRegistry *a) {
+  if (!a->renderer) return 0;
+  AssetBatch batch;
+  asset_batch_init(&batch);
+  for (int i = 0; i < a->count; i++) {
+    AssetEntry *e = &a->entries[i];
+    if (e->tex || e->failed) continue;
+    if (!e->preload && e->refcount <= 0) continue;
+    asset_batch_add(&batch, e->path, &e->tex, e->fallback);
+  }
+  int loaded = asset_batch_load(&batch, a->renderer);
+  asset_batch_free(&batch);
+  for (int i = 0; i < a->count; i++) {
+    AssetEntry *e = &a->entries[i];
+    if (!e->tex && (e->preload || e->refcount > 0)) e->failed = 1;
+  }
+  return loaded;
+}
+
+/* Drops resident textures nothing holds; they reload lazily if drawn again. */
+int assets_unload_unused(AssetRegistry *a) {
+  int freed = 0;
+  for (int i = 0; i < a->count; i++) {
+    AssetEntry *e = &a->entries[i];
+    if (!e->tex || e->preload || e->refcount > 0) continue;
+    SDL_DestroyTexture(e->tex);
+    e->tex = NULL;
+    freed++;
+  }
+  if (freed > 0) log_linef("Assets: unloaded %d unused textures (%d resident)", freed, assets_loaded_count(a));
+  return freed;
+}
+
+int assets_loaded_count(const AssetRegistry *a) {
+  int n = 0;
+  for (int i = 0; i < a->count; i++) {
+    if (a->entries[i].tex) n++;
+  }
+  return n;
+}
+
+void assets_free(AssetRegistry *a) {
+  for (int i = 0; i < a->count; i++) {
+    if (a->entries[i].tex) SDL_DestroyTexture(a->entries[i].tex);
+  }
+  SDL_Renderer *r = a->renderer;
+  memset(a, 0, sizeof(*a));
+  a->renderer = r;
+}
@@ -0,0 +1,189 @@
+#include "render/ground.h"
+
+#include "core/game.h"
+
+static unsigned int ground_hash(int tx, int ty, unsigned int salt) {
+  unsigned int h = ((unsigned int)tx * 73856093u) ^ ((unsigned int)ty * 19349663u) ^ salt;
+  h ^= h >> 13;
+  h *= 0x5bd1e995u;
+  h ^= h >> 15;
+  return h;
+}
+
+static int floor_div(int a, int b) {
+  int q = a / b;
+  if ((a % b != 0) && ((a < 0) != (b < 0))) q--;
+  return q;
+}
+
+/* Loads up to max images (first one from first_path if given, the rest from fmt)
+   and scales them into one horizontal strip so a whole layer shares a texture. */
+static SDL_Texture *ground_build_atlas(SDL_Renderer *r, const char *first_path, const char *fmt, int start,
+                                       int max, int size, int *out_count) {
+  SDL_Surface *surfs[MAX_GROUND_VARIANTS + MAX_GROUND_DECALS];
+  int count = 0;
+  *out_count = 0;
+  if (first_path) {
+    surfs[0] = IMG_Load(first_path);
+    if (!surfs[0]) return NULL;
+    count = 1;
+  }
+  for (int i = start; count < max; i++) {
+    char path[128];
+    snprintf(path, sizeof(path), fmt, i);
+    SDL_Surface *s = IMG_Load(path);
+    if (!s) break;
+    surfs[count++] = s;
+  }
+  if (count == 0) return NULL;
+
+  SDL_Texture *tex = NULL;
+  SDL_Surface *sheet = SDL_CreateRGBSurfaceWithFormat(0, size * count, size, 32, SDL_PIXELFORMAT_RGBA32);
+  if (sheet) {
+    for (int i = 0; i < count; i++) {
+      SDL_Rect dst = {i * size, 0, size, size};
+      SDL_SetSurfaceBlendMode(surfs[i], SDL_BLENDMODE_NONE);
+      SDL_BlitScaled(surfs[i], NULL, sheet, &dst);
+    }
+    tex = SDL_CreateTextureFromSurface(r, sheet);
+    SDL_FreeSurface(sheet);
+  }
+  for (int i = 0; i < count; i++) SDL_FreeSurface(surfs[i]);
+  if (tex) {
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    *out_count = count;
+  }
+  return tex;
+}
+
+int ground_load(GroundLayer *gl, SDL_Renderer *r) {
+  memset(gl, 0, sizeof(*gl));
+  gl->tile_size = GROUND_TILE_SIZE;
+  gl->decal_size = GROUND_DECAL_SIZE;
+  gl->atlas = ground_build_atlas(r, "data/assets/hd_ground_tile.png", "data/assets/env/ground_variant_%d.png", 1,
+                                 MAX_GROUND_VARIANTS, gl->tile_size, &gl->variant_count);
+  if (!gl->atlas) {
+    log_linef("Failed to load hd_ground_tile.png: %s", IMG_GetError());
+    return 0;
+  }
+  gl->decal_atlas = ground_build_atlas(r, NULL, "data/assets/env/ground_decal_%d.png", 0, MAX_GROUND_DECALS,
+                                       gl->decal_size, &gl->decal_count);
+  log_linef("Loaded hd_ground_tile.png (%d variants, %d decals)", gl->variant_count, gl->decal_count);
+  return 1;
+}
+
+void ground_free(GroundLayer *gl) {
+  if (gl->atlas) SDL_DestroyTexture(gl->atlas);
+  if (gl->decal_atlas) SDL_DestroyTexture(gl->decal_atlas);
+  free(gl->verts);
+  free(gl->indices);
+  memset(gl, 0, sizeof(*gl));
+}
+
+/* Variant 0 is the base tile and covers most of the floor. */
+int ground_variant_at(const GroundLayer *gl, int tx, int ty) {
+  if (gl->variant_count <= 1) return 0;
+  unsigned int h = ground_hash(tx, ty, 0x9e3779b9u);
+  if ((h & 0xff) < 192) return 0;
+  return 1 + (int)((h >> 8) % (unsigned int)(gl->variant_count - 1));
+}
+
+/* Returns -1 for tiles without a decal. */
+int ground_decal_at(const GroundLayer *gl, int tx, int ty) {
+  if (gl->decal_count <= 0) return -1;
+  unsigned int h = ground_hash(tx, ty, 0x85ebca6bu);
+  if ((h & 15) != 0) return -1;
+  return (int)((h >> 4) % (unsigned int)gl->decal_count);
+}
+
+static int ground_reserve(GroundLayer *gl, int quads) {
+  if (quads <= gl->quad_cap) return 1;
+  SDL_Vertex *verts = (SDL_Vertex *)realloc(gl->verts, sizeof(SDL_Vertex) * 4 * quads);
+  if (!verts) return 0;
+  gl->verts = verts;
+  int *indices = (int *)realloc(gl->indices, sizeof(int) * 6 * quads);
+  if (!indices) return 0;
+  gl->indices = indices;
+  for (int q = gl->quad_cap; q < quads; q++) {
+    int *idx = &gl->indices[q * 6];
+    int base = q * 4;
+    idx[0] = base;
+    idx[1] = base + 1;
+    idx[2] = base + 2;
+    idx[3] = base + 2;
+    idx[4] = base + 3;
+    idx[5] = base;
+  }
+  gl->quad_cap = quads;
+  return 1;
+}
+
+static void ground_put_quad(SDL_Vertex *v, float x, float y, float size, float u0, float u1) {
+  SDL_Color white = {255, 255, 255, 255};
+  v[0].position.x = x;
+  v[0].position.y = y;
+  v[0].tex_coord.x = u0;
+  v[0].tex_coord.y = 0.0f;
+  v[1].position.x = x + size;
+  v[1].position.y = y;
+  v[1].tex_coord.x = u1;
+  v[1].tex_coord.y = 0.0f;
+  v[2].position.x = x + size;
+  v[2].position.y = y + size;
+  v[2].tex_coord.x = u1;
+  v[2].tex_coord.y = 1.0f;
+  v[3].position.x = x;
+  v[3].position.y = y + size;
+  v[3].tex_coord.x = u0;
+  v[3].tex_coord.y = 1.0f;
+  for (int i = 0; i < 4; i++) v[i].color = white;
+}
+
+void ground_draw(GroundLayer *gl, SDL_Renderer *r, int cam_x, int cam_y, int offset_x, int offset_y,
+                 int view_w, int view_h) {
+  if (!gl->atlas) return;
+  int ts = gl->tile_size;
+  int tx0 = floor_div(cam_x, ts);
+  int ty0 = floor_div(cam_y, ts);
+  int tx1 = floor_div(cam_x + view_w - 1, ts);
+  int ty1 = floor_div(cam_y + view_h - 1, ts);
+  int quads = (tx1 - tx0 + 1) * (ty1 - ty0 + 1);
+  if (!ground_reserve(gl, quads)) return;
+
+  /* Half-texel inset keeps linear filtering from bleeding across atlas cells. */
+  float atlas_w = (float)(ts * gl->variant_count);
+  int n = 0;
+  for (int ty = ty0; ty <= ty1; ty++) {
+    for (int tx = tx0; tx <= tx1; tx++) {
+      int v = ground_variant_at(gl, tx, ty);
+      float u0 = ((float)(v * ts) + 0.5f) / atlas_w;
+      float u1 = ((float)((v + 1) * ts) - 0.5f) / atlas_w;
+      ground_put_quad(&gl->verts[n * 4], (float)(offset_x + tx * ts - cam_x), (float)(offset_y + ty * ts - cam_y),
+                      (float)ts, u0, u1);
+      n++;
+    }
+  }
+  SDL_RenderGeometry(r, gl->atlas, gl->verts, n * 4, gl->indices, n * 6);
+
+  if (!gl->decal_atlas) return;
+  int ds = gl->decal_size;
+  float decal_w = (float)(ds * gl->decal_count);
+  n = 0;
+  for (int ty = ty0; ty <= ty1; ty++) {
+    for (int tx = tx0; tx <= tx1; tx++) {
+      int d = ground_decal_at(gl, tx, ty);
+      if (d < 0) continue;
+      /* Decals stay inside their tile so the visible tile range is enough to cull them. */
+      unsigned int h = ground_hash(tx, ty, 0xc2b2ae35u);
+      int slack = ts - ds;
+      int ox = slack > 0 ? (int)(h % (unsigned int)(slack + 1)) : 0;
+      int oy = slack > 0 ? (int)((h >> 16) % (unsigned int)(slack + 1)) : 0;
+      float u0 = ((float)(d * ds) + 0.5f) / decal_w;
+      float u1 = ((float)((d + 1) * ds) - 0.5f) / decal_w;
+      ground_put_quad(&gl->verts[n * 4], (float)(offset_x + tx * ts + ox - cam_x),
+                      (float)(offset_y + ty * ts + oy - cam_y), (float)ds, u0, u1);
+      n++;
+    }
+  }
+  if (n > 0) SDL_RenderGeometry(r, gl->decal_atlas, gl->verts, n * 4, gl->indices, n * 6);
+}
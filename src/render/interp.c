@@ -0,0 +1,74 @@
+#include "render/interp.h"
+
+void interp_capture(Game *g) {
+  RenderInterp *ri = &g->interp;
+  if (!ri->enemy_x) return;
+  for (int i = 0; i < g->caps.enemies; i++) {
+    ri->enemy_x[i] = g->enemies[i].x;
+    ri->enemy_y[i] = g->enemies[i].y;
+    ri->enemy_gen[i] = g->enemies[i].gen;
+  }
+  ri->player_x = g->player.x;
+  ri->player_y = g->player.y;
+  ri->camera_x = g->camera_x;
+  ri->camera_y = g->camera_y;
+  ri->valid = 1;
+}
+
+void interp_set_alpha(Game *g, float alpha) {
+  if (alpha < 0.0f) alpha = 0.0f;
+  if (alpha > 1.0f) alpha = 1.0f;
+  g->interp.alpha = alpha;
+}
+
+/* Blends from prev toward cur; a jump wider than INTERP_SNAP_DIST
+   (respawn, knockback teleport, camera reset) is drawn where it landed. */
+static void blend(float px, float py, float *x, float *y, float t) {
+  float dx = *x - px;
+  float dy = *y - py;
+  if (dx * dx + dy * dy > INTERP_SNAP_DIST * INTERP_SNAP_DIST) return;
+  *x = px + dx * t;
+  *y = py + dy * t;
+}
+
+void interp_begin(Game *g) {
+  RenderInterp *ri = &g->interp;
+  ri->applied = 0;
+  if (!ri->valid || ri->alpha >= 1.0f) return;
+  int n = g->caps.enemies;
+  ri->live_x = SCRATCH_NEW(&g->frame_scratch, float, n);
+  ri->live_y = SCRATCH_NEW(&g->frame_scratch, float, n);
+  if (!ri->live_x || !ri->live_y) return;
+  float t = ri->alpha;
+
+  ri->live_player_x = g->player.x;
+  ri->live_player_y = g->player.y;
+  ri->live_camera_x = g->camera_x;
+  ri->live_camera_y = g->camera_y;
+  blend(ri->player_x, ri->player_y, &g->player.x, &g->player.y, t);
+  blend(ri->camera_x, ri->camera_y, &g->camera_x, &g->camera_y, t);
+
+  for (int i = 0; i < n; i++) {
+    Enemy *e = &g->enemies[i];
+    ri->live_x[i] = e->x;
+    ri->live_y[i] = e->y;
+    /* Slots spawned or reused this tick have no previous position. */
+    if (!e->active || ri->enemy_gen[i] != e->gen) continue;
+    blend(ri->enemy_x[i], ri->enemy_y[i], &e->x, &e->y, t);
+  }
+  ri->applied = 1;
+}
+
+void interp_end(Game *g) {
+  RenderInterp *ri = &g->interp;
+  if (!ri->applied) return;
+  g->player.x = ri->live_player_x;
+  g->player.y = ri->live_player_y;
+  g->camera_x = ri->live_camera_x;
+  g->camera_y = ri->live_camera_y;
+  for (int i = 0; i < g->caps.enemies; i++) {
+    g->enemies[i].x = ri->live_x[i];
+    g->enemies[i].y = ri->live_y[i];
+  }
+  ri->applied = 0;
+}
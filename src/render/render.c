@@ -1,5 +1,8 @@
 #include "render/render.h"
 
+#include "core/profiler.h"
+#include "systems/director.h"
+
 void draw_circle(SDL_Renderer *r, int cx, int cy, int radius, SDL_Color color) {
   const int segments = 48;
   SDL_SetRenderDrawColor(r, color.r, color.g, color.b, color.a);
@@ -98,11 +101,11 @@ void draw_sword_orbit(Game *g, int offset_x, int offset_y, float cam_x, float ca
     int draw_y = (int)(offset_y + mid_y - cam_y);
     float angle_deg = angle * (180.0f / 3.14159f) + 90.0f;
 
-    if (g->tex_dagger) {
+    if (game_tex(g, TEX_DAGGER)) {
       int length = (int)orbit_radius;
       int width = SWORD_ORBIT_WIDTH;
       SDL_Rect dst = { draw_x - width / 2, draw_y - length / 2, width, length };
-      SDL_RenderCopyEx(g->renderer, g->tex_dagger, NULL, &dst, angle_deg, NULL, SDL_FLIP_NONE);
+      SDL_RenderCopyEx(g->renderer, game_tex(g, TEX_DAGGER), NULL, &dst, angle_deg, NULL, SDL_FLIP_NONE);
     } else {
       draw_glow(g->renderer, draw_x, draw_y, 12, (SDL_Color){255, 220, 150, 120});
       draw_diamond(g->renderer, draw_x, draw_y, 10, (SDL_Color){255, 230, 180, 255});
@@ -137,3 +140,100 @@ void draw_sword_orbit(Game *g, int offset_x, int offset_y, float cam_x, float ca
   }
 }
 
+
+static int count_active_bullets(Game *g) {
+  int n = 0;
+  for (int i = 0; i < g->caps.bullets; i++) n += g->bullets[i].active;
+  return n;
+}
+
+void draw_profiler_overlay(Game *g) {
+  SDL_Renderer *r = g->renderer;
+  const int panel_w = 340;
+  const int line_h = 16;
+  const int graph_h = 60;
+  int x = g->window_w - panel_w - 10;
+  int y = 46;
+  int panel_h = line_h * (PROF_ZONE_COUNT + 7) + graph_h + 24;
+  SDL_Color text = {220, 224, 230, 255};
+  SDL_Color dim = {150, 156, 170, 255};
+  char buf[128];
+
+  SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(r, 8, 10, 16, 200);
+  SDL_Rect panel = {x, y, panel_w, panel_h};
+  SDL_RenderFillRect(r, &panel);
+
+  float avg = 0.0f;
+  float mx = 0.0f;
+  prof_frame_stats(&avg, &mx);
+  const ProfFrame *last = prof_frame_at(0);
+  snprintf(buf, sizeof(buf), "frame %.2f ms avg  %.2f max  (%d fps, %d ticks)", avg, mx,
+           avg > 0.0f ? (int)(1000.0f / avg + 0.5f) : 0, last ? last->sim_ticks : 0);
+  draw_text(r, g->font, x + 8, y + 4, text, buf);
+  int ty = y + 4 + line_h + 2;
+  for (int z = 0; z < PROF_ZONE_COUNT; z++) {
+    prof_zone_stats((ProfZone)z, &avg, &mx);
+    snprintf(buf, sizeof(buf), "%-16s %6.2f avg %6.2f max", prof_zone_name((ProfZone)z), avg, mx);
+    draw_text(r, g->font, x + 8, ty, z == PROF_SIM_TICK ? text : dim, buf);
+    ty += line_h;
+  }
+
+  int enemies = 0;
+  for (int i = 0; i < g->caps.enemies; i++) enemies += g->enemies[i].active;
+  int drops = 0;
+  for (int i = 0; i < g->caps.drops; i++) drops += g->drops[i].active;
+  int puddles = 0;
+  for (int i = 0; i < MAX_PUDDLES; i++) puddles += g->puddles[i].active;
+  int fx = 0;
+  for (int i = 0; i < MAX_WEAPON_FX; i++) fx += g->weapon_fx[i].active;
+  ty += 4;
+  snprintf(buf, sizeof(buf), "enemies %d/%d  drops %d/%d  merged %d  overflow %d", enemies, g->caps.enemies, drops,
+           g->caps.drops, g->drop_stats.merges, g->drop_stats.overflows);
+  draw_text(r, g->font, x + 8, ty, text, buf);
+  ty += line_h;
+  snprintf(buf, sizeof(buf), "bullets %d/%d  enemy %d/%d  puddles %d  fx %d", count_active_bullets(g), g->caps.bullets,
+           g->enemy_bullet_count, g->caps.enemy_bullets, puddles, fx);
+  draw_text(r, g->font, x + 8, ty, text, buf);
+  ty += line_h;
+  snprintf(buf, sizeof(buf), "enemy lod %d/%d/%d/%d  updated %d  crowd %s %d", g->enemy_lod_counts[0],
+           g->enemy_lod_counts[1], g->enemy_lod_counts[2], g->enemy_lod_counts[3], g->enemy_lod_updates,
+           g->crowd_disabled ? "off" : "on", g->crowd_neighbors);
+  draw_text(r, g->font, x + 8, ty, text, buf);
+  ty += line_h;
+  float interval = 0.0f;
+  int batch = 0;
+  int phase = director_sample(&g->director, g->game_time, &interval, &batch);
+  snprintf(buf, sizeof(buf), "spawn phase %d  batch %d/%.2fs  batches %d  starved %d", phase, batch, interval,
+           g->director.batches, g->director.starved);
+  draw_text(r, g->font, x + 8, ty, text, buf);
+  ty += line_h;
+  snprintf(buf, sizeof(buf), "scratch tick %zu/%zu KB  frame %zu/%zu KB  spills %d", g->tick_scratch.high_water / 1024,
+           g->tick_scratch.arena.size / 1024, g->frame_scratch.high_water / 1024, g->frame_scratch.arena.size / 1024,
+           g->tick_scratch.spills_total + g->frame_scratch.spills_total);
+  draw_text(r, g->font, x + 8, ty, text, buf);
+  ty += line_h + 6;
+
+  /* Frame-time graph, newest on the right; guides at 16.7 and 33.3 ms. */
+  const float graph_ms = 50.0f;
+  int gx = x + 8;
+  int gw = panel_w - 16;
+  SDL_Rect bars[PROF_HISTORY];
+  int bar_count = 0;
+  for (int age = 0; age < g_prof.count; age++) {
+    const ProfFrame *f = prof_frame_at(age);
+    int h = (int)(f->frame_ms / graph_ms * (float)graph_h);
+    if (h > graph_h) h = graph_h;
+    if (h < 1) h = 1;
+    int bx = gx + gw - 1 - age * gw / PROF_HISTORY;
+    bars[bar_count++] = (SDL_Rect){bx, ty + graph_h - h, gw / PROF_HISTORY > 1 ? gw / PROF_HISTORY : 1, h};
+  }
+  SDL_SetRenderDrawColor(r, 110, 200, 140, 220);
+  SDL_RenderFillRects(r, bars, bar_count);
+  SDL_SetRenderDrawColor(r, 220, 200, 90, 160);
+  int y60 = ty + graph_h - (int)(16.7f / graph_ms * (float)graph_h);
+  SDL_RenderDrawLine(r, gx, y60, gx + gw, y60);
+  SDL_SetRenderDrawColor(r, 230, 90, 80, 160);
+  int y30 = ty + graph_h - (int)(33.3f / graph_ms * (float)graph_h);
+  SDL_RenderDrawLine(r, gx, y30, gx + gw, y30);
+}
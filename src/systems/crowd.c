@@ -0,0 +1,295 @@
+#include "systems/crowd.h"
+
+#include <assert.h>
+
+#include "core/simd.h"
+
+typedef struct {
+  float x;
+  float y;
+  int neighbors;
+} CrowdPush;
+
+typedef struct {
+  int a;
+  int b;
+} CrowdRun;
+
+/* Adds the push on enemy k from the candidates in runs: each neighbour
+   inside CROWD_RADIUS contributes its unit offset weighted by how deep it
+   sits. Everything outside the radius, and k itself, weighs zero, so there
+   are no per-candidate branches; the vector loop masks off the lanes past
+   a run's end (the grid arrays carry CROWD_SCAN_PAD entries of slack).
+   Enemies on exactly the same spot are split along x by slot order. */
+static void crowd_accumulate(const float *xs, const float *ys, const int *ids, int k, const CrowdRun *runs,
+                             int run_count, CrowdPush *out) {
+  const float x = xs[k];
+  const float y = ys[k];
+  const int id = ids[k];
+  const float r2 = CROWD_RADIUS * CROWD_RADIUS;
+  const float inv_r = 1.0f / CROWD_RADIUS;
+#ifdef BUH_SSE2
+  const __m128 vx = _mm_set1_ps(x);
+  const __m128 vy = _mm_set1_ps(y);
+  const __m128i vid = _mm_set1_epi32(id);
+  const __m128i lane = _mm_setr_epi32(0, 1, 2, 3);
+  const __m128 vr2 = _mm_set1_ps(r2);
+  const __m128 vinv_r = _mm_set1_ps(inv_r);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 eps = _mm_set1_ps(1e-8f);
+  __m128 ax = zero;
+  __m128 ay = zero;
+  __m128 an = zero;
+  for (int r = 0; r < run_count; r++) {
+    const __m128i vend = _mm_set1_epi32(runs[r].b);
+    for (int j = runs[r].a; j < runs[r].b; j += 4) {
+      __m128 ox = _mm_sub_ps(vx, _mm_loadu_ps(&xs[j]));
+      __m128 oy = _mm_sub_ps(vy, _mm_loadu_ps(&ys[j]));
+      __m128 d2 = _mm_add_ps(_mm_mul_ps(ox, ox), _mm_mul_ps(oy, oy));
+      /* coincident: +-0.5 on x by slot order; k itself gets 0 */
+      __m128i ids_j = _mm_loadu_si128((const __m128i *)&ids[j]);
+      __m128 lower = _mm_castsi128_ps(_mm_cmplt_epi32(vid, ids_j));
+      __m128 higher = _mm_castsi128_ps(_mm_cmpgt_epi32(vid, ids_j));
+      __m128 split = _mm_or_ps(_mm_and_ps(lower, _mm_set1_ps(-0.5f)), _mm_and_ps(higher, half));
+      __m128 same = _mm_cmpeq_ps(d2, zero);
+      ox = _mm_or_ps(_mm_and_ps(same, split), _mm_andnot_ps(same, ox));
+      d2 = _mm_add_ps(_mm_mul_ps(ox, ox), _mm_mul_ps(oy, oy));
+      __m128 live = _mm_castsi128_ps(_mm_cmplt_epi32(_mm_add_epi32(_mm_set1_epi32(j), lane), vend));
+      __m128 inside = _mm_and_ps(live, _mm_and_ps(_mm_cmplt_ps(d2, vr2), _mm_cmpgt_ps(d2, zero)));
+      __m128 dc = _mm_max_ps(d2, eps);
+      __m128 inv = rsqrt_nr(dc);
+      __m128 depth = _mm_sub_ps(one, _mm_mul_ps(_mm_mul_ps(dc, inv), vinv_r));
+      __m128 w = _mm_and_ps(inside, _mm_mul_ps(depth, inv));
+      ax = _mm_add_ps(ax, _mm_mul_ps(ox, w));
+      ay = _mm_add_ps(ay, _mm_mul_ps(oy, w));
+      an = _mm_add_ps(an, _mm_and_ps(inside, one));
+    }
+  }
+  float lanes[4];
+  _mm_storeu_ps(lanes, ax);
+  out->x += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  _mm_storeu_ps(lanes, ay);
+  out->y += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  _mm_storeu_ps(lanes, an);
+  out->neighbors += (int)((lanes[0] + lanes[1]) + (lanes[2] + lanes[3]));
+#else
+  for (int r = 0; r < run_count; r++) {
+    for (int j = runs[r].a; j < runs[r].b; j++) {
+      float ox = x - xs[j];
+      float oy = y - ys[j];
+      if (ox == 0.0f && oy == 0.0f) ox = id < ids[j] ? -0.5f : (id > ids[j] ? 0.5f : 0.0f);
+      float d2 = ox * ox + oy * oy;
+      if (d2 <= 0.0f || d2 >= r2) continue;
+      float d = sqrtf(d2);
+      float w = (1.0f - d * inv_r) / d;
+      out->x += ox * w;
+      out->y += oy * w;
+      out->neighbors++;
+    }
+  }
+#endif
+}
+
+static int crowd_cell(float v, int limit) {
+  int c = (int)(v * (1.0f / CROWD_CELL));
+  return c < 0 ? 0 : (c >= limit ? limit - 1 : c);
+}
+
+/* Where an entry whose enemy died or whose slot was reused since the
+   rebuild sits: out of everyone's radius. */
+#define CROWD_GONE -1.0e6f
+
+/* Counting-sorts the active enemies into cg over their bounding box and
+   picks how many turns the round takes. */
+static void crowd_rebuild(Game *g, CrowdGrid *cg) {
+  int count = 0;
+  int c_lo = CROWD_GRID_COLS;
+  int c_hi = -1;
+  int r_lo = CROWD_GRID_ROWS;
+  int r_hi = -1;
+  for (int i = 0; i < g->caps.enemies; i++) {
+    const Enemy *e = &g->enemies[i];
+    if (!e->active) continue;
+    int c = crowd_cell(e->x, CROWD_GRID_COLS);
+    int r = crowd_cell(e->y, CROWD_GRID_ROWS);
+    if (c < c_lo) c_lo = c;
+    if (c > c_hi) c_hi = c;
+    if (r < r_lo) r_lo = r;
+    if (r > r_hi) r_hi = r;
+    count++;
+  }
+  cg->count = count;
+  if (count < 2) return;
+  cg->cols = c_hi - c_lo + 1;
+  cg->rows = r_hi - r_lo + 1;
+  cg->stride = (count + CROWD_TICK_ENEMIES - 1) / CROWD_TICK_ENEMIES;
+  if (cg->stride > CROWD_MAX_STRIDE) cg->stride = CROWD_MAX_STRIDE;
+  const int cells = cg->cols * cg->rows;
+
+  Scratch *s = &g->tick_scratch;
+  size_t mark = scratch_mark(s);
+  int *key = SCRATCH_NEW(s, int, g->caps.enemies);
+  assert(key);
+  int *start = cg->start;
+  memset(start, 0, sizeof(int) * (size_t)(cells + 1));
+  for (int i = 0; i < g->caps.enemies; i++) {
+    const Enemy *e = &g->enemies[i];
+    if (!e->active) continue;
+    key[i] = (crowd_cell(e->y, CROWD_GRID_ROWS) - r_lo) * cg->cols + crowd_cell(e->x, CROWD_GRID_COLS) - c_lo;
+    start[key[i]]++;
+  }
+  for (int c = 1; c < cells; c++) start[c] += start[c - 1];
+  start[cells] = count;
+  for (int i = g->caps.enemies - 1; i >= 0; i--) {
+    const Enemy *e = &g->enemies[i];
+    if (!e->active) continue;
+    int k = --start[key[i]];
+    cg->ids[k] = i;
+    cg->cell[k] = key[i];
+    cg->gen[k] = e->gen;
+    cg->x[k] = e->x;
+    cg->y[k] = e->y;
+  }
+  for (int k = count; k < count + CROWD_SCAN_PAD; k++) {
+    cg->ids[k] = -1;
+    cg->x[k] = CROWD_GONE;
+    cg->y[k] = CROWD_GONE;
+  }
+  scratch_release(s, mark);
+}
+
+/* Re-reads live positions for sorted entries [lo, hi). */
+static void crowd_refresh(const Game *g, CrowdGrid *cg, int lo, int hi) {
+  for (int k = lo; k < hi; k++) {
+    const Enemy *e = &g->enemies[cg->ids[k]];
+    int live = e->active && e->gen == cg->gen[k];
+    cg->x[k] = live ? e->x : CROWD_GONE;
+    cg->y[k] = live ? e->y : CROWD_GONE;
+  }
+}
+
+/* Pushes overlapping enemies apart. The weapon grid's cells are several
+   times the crowd radius, so most of their contents would be misses;
+   instead enemies are counting-sorted into CROWD_CELL cells, and the 3x3
+   block around a cell is three contiguous runs shared by every enemy in
+   it. Each enemy scans at most CROWD_MAX_SCAN candidates.
+
+   Past CROWD_TICK_ENEMIES the work is spread over a round of turns: the
+   grid is built on the first, and each turn refreshes the push of one
+   slice of the sorted order, after re-reading the positions it and the
+   rows around it need. Every enemy moves by its last push each tick, so
+   turns change how fresh a push is, not how far anyone steps at once. */
+void crowd_separate(Game *g, float dt) {
+  CrowdGrid *cg = &g->crowd_grid;
+  g->crowd_neighbors = 0;
+  g->crowd_pushed = 0;
+  if (g->crowd_disabled) {
+    cg->turn = 0;
+    return;
+  }
+  if (cg->turn == 0) crowd_rebuild(g, cg);
+  if (cg->count < 2) return;
+
+  const int cols = cg->cols;
+  const int rows = cg->rows;
+  const int *start = cg->start;
+  const int a = (int)((long long)cg->count * cg->turn / cg->stride);
+  const int b = (int)((long long)cg->count * (cg->turn + 1) / cg->stride);
+  cg->turn = (cg->turn + 1) % cg->stride;
+  if (a < b) {
+    int r0 = cg->cell[a] / cols;
+    int r1 = cg->cell[b - 1] / cols;
+    crowd_refresh(g, cg, start[(r0 > 0 ? r0 - 1 : 0) * cols], start[(r1 + 2 < rows ? r1 + 2 : rows) * cols]);
+  }
+
+  Scratch *s = &g->tick_scratch;
+  size_t mark = scratch_mark(s);
+  int def_count = g->db.enemy_count > 0 ? g->db.enemy_count : 1;
+  unsigned char *anchored = SCRATCH_NEW(s, unsigned char, def_count);
+  assert(anchored);
+  /* Turrets and bosses hold their ground but still push others away. */
+  for (int d = 0; d < g->db.enemy_count; d++) {
+    const char *role = g->db.enemies[d].role;
+    anchored[d] = strcmp(role, "turret") == 0 || strcmp(role, "boss") == 0;
+  }
+
+  const float *xs = cg->x;
+  const float *ys = cg->y;
+  const int *ids = cg->ids;
+  int total = 0;
+  int pushed = 0;
+  int cell = -1;
+  int row_a[3];
+  int row_b[3];
+  int rows_near = 0;
+  for (int k = a; k < b; k++) {
+    if (xs[k] == CROWD_GONE) continue;
+    if (cg->cell[k] != cell) {
+      cell = cg->cell[k];
+      int r = cell / cols;
+      int c = cell - r * cols;
+      int lc = c > 0 ? c - 1 : c;
+      int hc = c + 1 < cols ? c + 1 : c;
+      const int order[3] = {r, r - 1, r + 1}; /* own row first */
+      rows_near = 0;
+      for (int q = 0; q < 3; q++) {
+        int rr = order[q];
+        if (rr < 0 || rr >= rows) continue;
+        row_a[rows_near] = start[rr * cols + lc];
+        row_b[rows_near] = start[rr * cols + hc + 1];
+        rows_near++;
+      }
+    }
+    /* Own row first, from this enemy onward and wrapping, so in a packed
+       cell the scan budget covers everyone's surroundings evenly. */
+    CrowdRun scan[4];
+    int scan_count = 0;
+    int budget = CROWD_MAX_SCAN;
+    if (row_b[0] - row_a[0] <= budget) {
+      scan[scan_count++] = (CrowdRun){row_a[0], row_b[0]};
+      budget -= row_b[0] - row_a[0];
+    } else {
+      int end = k + budget < row_b[0] ? k + budget : row_b[0];
+      scan[scan_count++] = (CrowdRun){k, end};
+      budget -= end - k;
+      end = row_a[0] + budget < k ? row_a[0] + budget : k;
+      scan[scan_count++] = (CrowdRun){row_a[0], end};
+      budget -= end - row_a[0];
+    }
+    for (int q = 1; q < rows_near && budget > 0; q++) {
+      int end = row_a[q] + budget < row_b[q] ? row_a[q] + budget : row_b[q];
+      scan[scan_count++] = (CrowdRun){row_a[q], end};
+      budget -= end - row_a[q];
+    }
+    CrowdPush push = {0.0f, 0.0f, 0};
+    crowd_accumulate(xs, ys, ids, k, scan, scan_count, &push);
+    Enemy *e = &g->enemies[ids[k]];
+    int hold = anchored[e->def_index];
+    e->crowd_vx = hold ? 0.0f : push.x * CROWD_STRENGTH;
+    e->crowd_vy = hold ? 0.0f : push.y * CROWD_STRENGTH;
+    total += push.neighbors;
+    pushed++;
+  }
+  g->crowd_neighbors = total;
+  g->crowd_pushed = pushed;
+  scratch_release(s, mark);
+
+  for (int i = 0; i < g->caps.enemies; i++) {
+    Enemy *e = &g->enemies[i];
+    if (!e->active || (e->crowd_vx == 0.0f && e->crowd_vy == 0.0f)) continue;
+    float sx = e->crowd_vx * dt;
+    float sy = e->crowd_vy * dt;
+    float len2 = sx * sx + sy * sy;
+    if (len2 > CROWD_MAX_STEP * CROWD_MAX_STEP) {
+      float scale = CROWD_MAX_STEP / sqrtf(len2);
+      sx *= scale;
+      sy *= scale;
+    }
+    float x = e->x + sx;
+    float y = e->y + sy;
+    e->x = x < ENEMY_RADIUS ? ENEMY_RADIUS : (x > ARENA_W - ENEMY_RADIUS ? ARENA_W - ENEMY_RADIUS : x);
+    e->y = y < ENEMY_RADIUS ? ENEMY_RADIUS : (y > ARENA_H - ENEMY_RADIUS ? ARENA_H - ENEMY_RADIUS : y);
+  }
+}
@@ -0,0 +1,196 @@
+#include "systems/debuffs.h"
+
+#define WHEEL_BITS 6
+#define WHEEL_MASK (DEBUFF_WHEEL_SLOTS - 1)
+/* Level 1 spans 64 level-0 revolutions; later nodes park in its last slot. */
+#define WHEEL_HORIZON ((DEBUFF_WHEEL_SLOTS - 1) << WHEEL_BITS)
+
+static unsigned int time_to_tick(float t) {
+  return (unsigned int)ceilf(t * (float)DEBUFF_TICK_HZ);
+}
+
+static void wheel_unlink(DebuffSystem *d, int e) {
+  int lvl = d->level[e];
+  if (lvl < 0) return;
+  int slot = lvl == 0 ? (int)(d->due[e] & WHEEL_MASK) : (int)((d->due[e] >> WHEEL_BITS) & WHEEL_MASK);
+  if (d->prev[e] >= 0) d->next[d->prev[e]] = d->next[e];
+  else d->wheel[lvl][slot] = d->next[e];
+  if (d->next[e] >= 0) d->prev[d->next[e]] = d->prev[e];
+  d->level[e] = -1;
+}
+
+static void wheel_insert(DebuffSystem *d, int e, unsigned int due) {
+  if (due <= d->tick) due = d->tick + 1;
+  if (due - d->tick > WHEEL_HORIZON) due = d->tick + WHEEL_HORIZON;
+  d->due[e] = due;
+  int lvl = due - d->tick < DEBUFF_WHEEL_SLOTS ? 0 : 1;
+  int slot = lvl == 0 ? (int)(due & WHEEL_MASK) : (int)((due >> WHEEL_BITS) & WHEEL_MASK);
+  d->level[e] = (signed char)lvl;
+  d->prev[e] = -1;
+  d->next[e] = d->wheel[lvl][slot];
+  if (d->next[e] >= 0) d->prev[d->next[e]] = e;
+  d->wheel[lvl][slot] = e;
+}
+
+static void set_add(DebuffSystem *d, int e) {
+  if (d->active_pos[e] >= 0) return;
+  d->active_pos[e] = d->active_count;
+  d->active[d->active_count++] = e;
+}
+
+static void set_remove(DebuffSystem *d, int e) {
+  int pos = d->active_pos[e];
+  if (pos < 0) return;
+  int last = d->active[--d->active_count];
+  d->active[pos] = last;
+  d->active_pos[last] = pos;
+  d->active_pos[e] = -1;
+}
+
+/* Earliest pending expiry among the kinds still in the mask. */
+static float next_expiry(const Enemy *en) {
+  float t = 0.0f;
+  int found = 0;
+  for (int k = 0; k < DEBUFF_KIND_COUNT; k++) {
+    if (!(en->debuffs.mask & (1u << k))) continue;
+    if (!found || en->debuffs.until[k] < t) t = en->debuffs.until[k];
+    found = 1;
+  }
+  return t;
+}
+
+void debuffs_reset(Game *g) {
+  DebuffSystem *d = &g->debuffs;
+  d->ready = 1;
+  d->now = 0.0f;
+  d->tick = 0;
+  for (int l = 0; l < 2; l++) {
+    for (int s = 0; s < DEBUFF_WHEEL_SLOTS; s++) d->wheel[l][s] = -1;
+  }
+  for (int i = 0; i < g->caps.enemies; i++) {
+    d->level[i] = -1;
+    d->active_pos[i] = -1;
+  }
+  d->active_count = 0;
+}
+
+/* Re-derives the set and wheel from the enemy array after it was replaced
+   wholesale (snapshot restore), keeping the clock. */
+void debuffs_rebuild(Game *g) {
+  DebuffSystem *d = &g->debuffs;
+  float now = d->now;
+  unsigned int tick = d->tick;
+  debuffs_reset(g);
+  d->now = now;
+  d->tick = tick;
+  for (int i = 0; i < g->caps.enemies; i++) {
+    Enemy *en = &g->enemies[i];
+    if (!en->active || en->debuffs.mask == 0) continue;
+    set_add(d, i);
+    wheel_insert(d, i, time_to_tick(next_expiry(en)));
+  }
+}
+
+void debuffs_clear(Game *g, int enemy) {
+  DebuffSystem *d = &g->debuffs;
+  if (enemy < 0 || enemy >= g->caps.enemies) return;
+  if (!d->ready) debuffs_reset(g);
+  wheel_unlink(d, enemy);
+  set_remove(d, enemy);
+  memset(&g->enemies[enemy].debuffs, 0, sizeof(g->enemies[enemy].debuffs));
+}
+
+/* Sets the effect to last duration seconds from now, like assigning a timer. */
+void debuff_apply(Game *g, Enemy *en, DebuffKind kind, float duration) {
+  DebuffSystem *d = &g->debuffs;
+  int e = (int)(en - g->enemies);
+  if (e < 0 || e >= g->caps.enemies || duration <= 0.0f) return;
+  if (!d->ready) debuffs_reset(g);
+  float until = d->now + duration;
+  en->debuffs.until[kind] = until;
+  en->debuffs.mask |= 1u << kind;
+  set_add(d, e);
+  unsigned int due = time_to_tick(until);
+  if (d->level[e] < 0 || due < d->due[e]) {
+    wheel_unlink(d, e);
+    wheel_insert(d, e, due);
+  }
+}
+
+/* Applies only if it would lengthen the effect. */
+void debuff_extend(Game *g, Enemy *en, DebuffKind kind, float duration) {
+  if (debuff_remaining(g, en, kind) < duration) debuff_apply(g, en, kind, duration);
+}
+
+void debuff_add_bleed(Game *g, Enemy *en, float duration) {
+  if (!debuff_active(g, en, DEBUFF_BLEED)) en->debuffs.bleed_stacks = 0;
+  if (en->debuffs.bleed_stacks < 5) en->debuffs.bleed_stacks++;
+  debuff_apply(g, en, DEBUFF_BLEED, duration);
+}
+
+float debuff_remaining(const Game *g, const Enemy *en, DebuffKind kind) {
+  float r = en->debuffs.until[kind] - g->debuffs.now;
+  return r > 0.0f ? r : 0.0f;
+}
+
+/* Drops expired kinds; re-arms the node for whatever is left. */
+static void expire_enemy(Game *g, int e) {
+  DebuffSystem *d = &g->debuffs;
+  Enemy *en = &g->enemies[e];
+  for (int k = 0; k < DEBUFF_KIND_COUNT; k++) {
+    if ((en->debuffs.mask & (1u << k)) && en->debuffs.until[k] <= d->now) en->debuffs.mask &= ~(1u << k);
+  }
+  if (!(en->debuffs.mask & (1u << DEBUFF_BLEED))) en->debuffs.bleed_stacks = 0;
+  if (en->debuffs.mask == 0 || !en->active) {
+    en->debuffs.mask = 0;
+    set_remove(d, e);
+    return;
+  }
+  wheel_insert(d, e, time_to_tick(next_expiry(en)));
+}
+
+static void wheel_advance(Game *g, unsigned int target) {
+  DebuffSystem *d = &g->debuffs;
+  while (d->tick < target) {
+    d->tick++;
+    if ((d->tick & WHEEL_MASK) == 0) {
+      int slot = (int)((d->tick >> WHEEL_BITS) & WHEEL_MASK);
+      int e = d->wheel[1][slot];
+      d->wheel[1][slot] = -1;
+      while (e >= 0) {
+        int next = d->next[e];
+        d->level[e] = -1;
+        wheel_insert(d, e, d->due[e]);
+        e = next;
+      }
+    }
+    int slot = (int)(d->tick & WHEEL_MASK);
+    int e = d->wheel[0][slot];
+    d->wheel[0][slot] = -1;
+    while (e >= 0) {
+      int next = d->next[e];
+      d->level[e] = -1;
+      expire_enemy(g, e);
+      e = next;
+    }
+  }
+}
+
+/* Batched DoT over the active set for [now, now + dt), then advances the
+   clock and expires whatever ran out. Each DoT only counts the part of the
+   tick its effect covers, so totals match the applied duration exactly. */
+void debuffs_update(Game *g, float dt) {
+  DebuffSystem *d = &g->debuffs;
+  const unsigned int dot_mask = (1u << DEBUFF_BURN) | (1u << DEBUFF_BLEED) | (1u << DEBUFF_CURSE);
+  if (!d->ready) debuffs_reset(g);
+  for (int i = 0; i < d->active_count; i++) {
+    Enemy *en = &g->enemies[d->active[i]];
+    if (!en->active || !(en->debuffs.mask & dot_mask)) continue;
+    float burn = clampf(en->debuffs.until[DEBUFF_BURN] - d->now, 0.0f, dt);
+    float bleed = clampf(en->debuffs.until[DEBUFF_BLEED] - d->now, 0.0f, dt);
+    float curse = clampf(en->debuffs.until[DEBUFF_CURSE] - d->now, 0.0f, dt);
+    en->hp -= 4.0f * burn + en->debuffs.bleed_stacks * 1.5f * bleed + en->debuffs.curse_dps * curse;
+  }
+  d->now += dt;
+  wheel_advance(g, (unsigned int)floorf(d->now * (float)DEBUFF_TICK_HZ));
+}
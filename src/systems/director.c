@@ -0,0 +1,180 @@
+#include "systems/director.h"
+
+#include "data/registry.h"
+#include "systems/enemies.h"
+
+/* Used when data/spawn_curve.json is missing: one enemy of any kind per second. */
+static const SpawnPhase k_default_phase = {0.0f, 1.0f, 1, SPAWN_EDGE, {{0}}, 0};
+
+void director_reset(Game *g) {
+  SpawnDirector *d = &g->director;
+  d->batches = 0;
+  d->spawned = 0;
+  d->starved = 0;
+}
+
+/* Unit directions for ring and swarm placement, built once. */
+static void ring_warm(SpawnDirector *d) {
+  if (d->ring_ready) return;
+  for (int i = 0; i < SPAWN_RING_SLOTS; i++) {
+    float a = (float)i * (6.2831853f / (float)SPAWN_RING_SLOTS);
+    d->ring_cos[i] = cosf(a);
+    d->ring_sin[i] = sinf(a);
+  }
+  d->ring_ready = 1;
+}
+
+static const SpawnPhase *phase_at(const SpawnDirector *d, int i) {
+  return d->phase_count > 0 ? &d->phases[i] : &k_default_phase;
+}
+
+/* Finds the phase covering t and eases interval and batch toward the next
+   one. Returns the phase index. */
+int director_sample(const SpawnDirector *d, float t, float *interval, int *batch) {
+  int n = d->phase_count > 0 ? d->phase_count : 1;
+  int i = 0;
+  while (i + 1 < n && t >= phase_at(d, i + 1)->start) i++;
+  const SpawnPhase *ph = phase_at(d, i);
+  float iv = ph->interval;
+  float b = (float)ph->batch;
+  if (i + 1 < n) {
+    const SpawnPhase *next = phase_at(d, i + 1);
+    float span = next->start - ph->start;
+    float u = span > 0.0f ? clampf((t - ph->start) / span, 0.0f, 1.0f) : 0.0f;
+    iv += (next->interval - iv) * u;
+    b += ((float)next->batch - b) * u;
+  }
+  *interval = iv;
+  *batch = (int)(b + 0.5f);
+  if (*batch < 1) *batch = 1;
+  return i;
+}
+
+/* A point just outside a random camera edge, as single spawns always used. */
+static void edge_point(Game *g, float margin, float *x, float *y) {
+  float cam_min_x = g->camera_x;
+  float cam_max_x = g->camera_x + g->view_w;
+  float cam_min_y = g->camera_y;
+  float cam_max_y = g->camera_y + g->view_h;
+  int side = rand() % 4;
+  if (side == 0) {
+    *x = cam_min_x - margin;
+    *y = cam_min_y + frandf() * g->view_h;
+  } else if (side == 1) {
+    *x = cam_max_x + margin;
+    *y = cam_min_y + frandf() * g->view_h;
+  } else if (side == 2) {
+    *x = cam_min_x + frandf() * g->view_w;
+    *y = cam_min_y - margin;
+  } else {
+    *x = cam_min_x + frandf() * g->view_w;
+    *y = cam_max_y + margin;
+  }
+}
+
+static void place_batch(Game *g, SpawnPattern pattern, int count, float *xs, float *ys) {
+  SpawnDirector *d = &g->director;
+  Player *p = &g->player;
+  if (pattern == SPAWN_RING) {
+    ring_warm(d);
+    float r = 0.5f * sqrtf((float)(g->view_w * g->view_w + g->view_h * g->view_h)) + SPAWN_EDGE_MARGIN;
+    int base = rand() & (SPAWN_RING_SLOTS - 1);
+    for (int k = 0; k < count; k++) {
+      /* full rings of SPAWN_RING_SLOTS stack outward, the last one spreads evenly */
+      int layer = k / SPAWN_RING_SLOTS;
+      int left = count - layer * SPAWN_RING_SLOTS;
+      int in_layer = left < SPAWN_RING_SLOTS ? left : SPAWN_RING_SLOTS;
+      int slot = (base + (k % SPAWN_RING_SLOTS) * SPAWN_RING_SLOTS / in_layer) & (SPAWN_RING_SLOTS - 1);
+      float rk = r + (float)layer * 2.0f * ENEMY_RADIUS;
+      xs[k] = p->x + d->ring_cos[slot] * rk;
+      ys[k] = p->y + d->ring_sin[slot] * rk;
+    }
+  } else if (pattern == SPAWN_SWARM) {
+    ring_warm(d);
+    float cx = 0.0f;
+    float cy = 0.0f;
+    edge_point(g, SPAWN_EDGE_MARGIN + SPAWN_SWARM_RADIUS, &cx, &cy);
+    for (int k = 0; k < count; k++) {
+      int slot = rand() & (SPAWN_RING_SLOTS - 1);
+      float rk = SPAWN_SWARM_RADIUS * frandf();
+      xs[k] = cx + d->ring_cos[slot] * rk;
+      ys[k] = cy + d->ring_sin[slot] * rk;
+    }
+  } else if (pattern == SPAWN_LINE) {
+    float spacing = 2.0f * ENEMY_RADIUS + 4.0f;
+    float half = 0.5f * spacing * (float)(count - 1);
+    int side = rand() % 4;
+    int vertical = side < 2;
+    float along = vertical ? g->camera_y + frandf() * g->view_h : g->camera_x + frandf() * g->view_w;
+    float fixed = side == 0   ? g->camera_x - SPAWN_EDGE_MARGIN
+                  : side == 1 ? g->camera_x + g->view_w + SPAWN_EDGE_MARGIN
+                  : side == 2 ? g->camera_y - SPAWN_EDGE_MARGIN
+                              : g->camera_y + g->view_h + SPAWN_EDGE_MARGIN;
+    for (int k = 0; k < count; k++) {
+      float a = along - half + (float)k * spacing;
+      xs[k] = vertical ? fixed : a;
+      ys[k] = vertical ? a : fixed;
+    }
+  } else {
+    for (int k = 0; k < count; k++) edge_point(g, SPAWN_EDGE_MARGIN, &xs[k], &ys[k]);
+  }
+
+  for (int k = 0; k < count; k++) {
+    xs[k] = xs[k] < 40.0f ? 40.0f : (xs[k] > ARENA_W - 40.0f ? ARENA_W - 40.0f : xs[k]);
+    ys[k] = ys[k] < 40.0f ? 40.0f : (ys[k] > ARENA_H - 40.0f ? ARENA_H - 40.0f : ys[k]);
+  }
+}
+
+/* Allocates, places and initialises a whole batch at once. With no defs
+   given each enemy picks any def. Returns how many were spawned. */
+int spawn_enemy_batch(Game *g, const int *defs, int def_count, SpawnPattern pattern, int count) {
+  SpawnDirector *d = &g->director;
+  if (count > MAX_SPAWN_BATCH) count = MAX_SPAWN_BATCH;
+  if (count <= 0 || (def_count <= 0 && g->db.enemy_count <= 0)) return 0;
+  int slots[MAX_SPAWN_BATCH];
+  float xs[MAX_SPAWN_BATCH];
+  float ys[MAX_SPAWN_BATCH];
+  int got = enemy_alloc_batch(g, slots, count);
+  d->starved += count - got;
+  if (got == 0) return 0;
+  place_batch(g, pattern, got, xs, ys);
+  for (int k = 0; k < got; k++) {
+    int def = def_count > 0 ? defs[def_count > 1 ? rand() % def_count : 0] : rand() % g->db.enemy_count;
+    enemy_init(g, slots[k], def, xs[k], ys[k]);
+  }
+  d->batches++;
+  d->spawned += got;
+  return got;
+}
+
+static SpawnPattern pick_pattern(unsigned int patterns) {
+  SpawnPattern options[4];
+  int n = 0;
+  for (int bit = 0; bit < 4; bit++) {
+    if (patterns & (1u << bit)) options[n++] = (SpawnPattern)(1u << bit);
+  }
+  return n > 0 ? options[rand() % n] : SPAWN_EDGE;
+}
+
+/* Counts down to the next batch and emits it from the phase the run is in. */
+void director_update(Game *g, float dt) {
+  SpawnDirector *d = &g->director;
+  g->spawn_timer -= dt;
+  if (g->spawn_timer > 0.0f) return;
+  if (g->db.enemy_count <= 0) {
+    g->spawn_timer = 1.0f;
+    return;
+  }
+  float interval = 1.0f;
+  int batch = 1;
+  const SpawnPhase *ph = phase_at(d, director_sample(d, g->game_time, &interval, &batch));
+  int defs[MAX_SPAWN_PHASE_ENEMIES];
+  int def_count = 0;
+  for (int i = 0; i < ph->enemy_count; i++) {
+    int idx = find_enemy(&g->db, ph->enemies[i]);
+    if (idx >= 0) defs[def_count++] = idx;
+  }
+  spawn_enemy_batch(g, defs, def_count, pick_pattern(ph->patterns), batch);
+  float next = interval * g->skill_tree_spawn_scale;
+  g->spawn_timer = next > SPAWN_MIN_INTERVAL ? next : SPAWN_MIN_INTERVAL;
+}
@@ -0,0 +1,137 @@
+#include "systems/drops.h"
+
+#include "core/simd.h"
+
+void drops_clear(Game *g) {
+  for (int i = 0; i < g->caps.drops; i++) g->drops[i].active = 0;
+  memset(&g->drop_stats, 0, sizeof(g->drop_stats));
+}
+
+/* One pass finds a free slot, the closest resting orb inside the merge radius
+   and the closest orb of any kind. A full pool folds the XP into that last one
+   rather than dropping it; with no XP orb at all it is banked for the next. */
+int drops_spawn_xp(Game *g, float x, float y, float value) {
+  DropStats *st = &g->drop_stats;
+  value += st->banked_xp;
+  st->banked_xp = 0.0f;
+  int free_slot = -1;
+  int merge = -1;
+  int nearest = -1;
+  float merge_d2 = DROP_MERGE_RADIUS * DROP_MERGE_RADIUS;
+  float nearest_d2 = 0.0f;
+  for (int i = 0; i < g->caps.drops; i++) {
+    Drop *d = &g->drops[i];
+    if (!d->active) {
+      if (free_slot < 0) free_slot = i;
+      continue;
+    }
+    if (d->type != 0) continue;
+    float dx = d->x - x;
+    float dy = d->y - y;
+    float d2 = dx * dx + dy * dy;
+    if (!d->magnetized && d2 <= merge_d2) {
+      merge = i;
+      merge_d2 = d2;
+    }
+    if (nearest < 0 || d2 < nearest_d2) {
+      nearest = i;
+      nearest_d2 = d2;
+    }
+  }
+
+  if (merge < 0 && free_slot < 0) {
+    st->overflows++;
+    merge = nearest;
+  }
+  if (merge >= 0) {
+    g->drops[merge].value += value;
+    g->drops[merge].ttl = 10.0f;
+    st->merges++;
+    return merge;
+  }
+  if (free_slot < 0) {
+    st->banked_xp += value;
+    return -1;
+  }
+
+  Drop *d = &g->drops[free_slot];
+  memset(d, 0, sizeof(*d));
+  d->active = 1;
+  d->type = 0;
+  d->x = x;
+  d->y = y;
+  d->value = value;
+  d->ttl = 10.0f;
+  return free_slot;
+}
+
+static void magnet_span(float *xs, float *ys, float *speeds, int n, float px, float py, float dt) {
+  int i = 0;
+#ifdef BUH_SSE2
+  const __m128 vdt = _mm_set1_ps(dt);
+  const __m128 accel = _mm_set1_ps(DROP_MAGNET_ACCEL * dt);
+  const __m128 max_speed = _mm_set1_ps(DROP_MAGNET_MAX_SPEED);
+  const __m128 vpx = _mm_set1_ps(px);
+  const __m128 vpy = _mm_set1_ps(py);
+  const __m128 eps = _mm_set1_ps(1e-8f);
+  const __m128 one = _mm_set1_ps(1.0f);
+  for (; i + 4 <= n; i += 4) {
+    __m128 x = _mm_loadu_ps(&xs[i]);
+    __m128 y = _mm_loadu_ps(&ys[i]);
+    __m128 speed = _mm_min_ps(_mm_add_ps(_mm_loadu_ps(&speeds[i]), accel), max_speed);
+    __m128 dx = _mm_sub_ps(vpx, x);
+    __m128 dy = _mm_sub_ps(vpy, y);
+    __m128 d2 = _mm_max_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), eps);
+    __m128 inv = rsqrt_nr(d2);
+    __m128 t = _mm_min_ps(_mm_mul_ps(_mm_mul_ps(speed, vdt), inv), one);
+    _mm_storeu_ps(&xs[i], _mm_add_ps(x, _mm_mul_ps(dx, t)));
+    _mm_storeu_ps(&ys[i], _mm_add_ps(y, _mm_mul_ps(dy, t)));
+    _mm_storeu_ps(&speeds[i], speed);
+  }
+#endif
+  for (; i < n; i++) {
+    float speed = speeds[i] + DROP_MAGNET_ACCEL * dt;
+    if (speed > DROP_MAGNET_MAX_SPEED) speed = DROP_MAGNET_MAX_SPEED;
+    float dx = px - xs[i];
+    float dy = py - ys[i];
+    float d2 = dx * dx + dy * dy;
+    if (d2 > 1e-8f) {
+      float t = speed * dt / sqrtf(d2);
+      if (t > 1.0f) t = 1.0f;
+      xs[i] += dx * t;
+      ys[i] += dy * t;
+    }
+    speeds[i] = speed;
+  }
+}
+
+/* Attracted drops are gathered into flat arrays so the pull toward the
+   player runs four at a time; a drop never steps past the player. Pools
+   larger than one chunk are walked a chunk at a time. */
+void drops_magnet_step(Game *g, float px, float py, float dt) {
+  float xs[DROP_MAGNET_CHUNK];
+  float ys[DROP_MAGNET_CHUNK];
+  float speeds[DROP_MAGNET_CHUNK];
+  int idx[DROP_MAGNET_CHUNK];
+  int next = 0;
+  while (next < g->caps.drops) {
+    int n = 0;
+    for (; next < g->caps.drops && n < DROP_MAGNET_CHUNK; next++) {
+      Drop *d = &g->drops[next];
+      if (!d->active || !d->magnetized) continue;
+      idx[n] = next;
+      xs[n] = d->x;
+      ys[n] = d->y;
+      speeds[n] = d->magnet_speed;
+      n++;
+    }
+    if (n == 0) return;
+    magnet_span(xs, ys, speeds, n, px, py, dt);
+    for (int k = 0; k < n; k++) {
+      Drop *d = &g->drops[idx[k]];
+      d->x = xs[k];
+      d->y = ys[k];
+      d->magnet_speed = speeds[k];
+    }
+  }
+}
@@ -1,5 +1,10 @@
 #include "systems/enemies.h"
 
+#include "systems/debuffs.h"
+#include "systems/director.h"
+#include "systems/hits.h"
+#include "systems/weapons.h"
+
 const char *enemy_label(Game *g, Enemy *e) {
   if (!g || !e) return "enemy";
   int idx = e->def_index;
@@ -7,109 +12,112 @@ const char *enemy_label(Game *g, Enemy *e) {
   return "enemy";
 }
 
+/* Collects up to n free slots in one sweep, starting where the previous
+   allocation left off so a busy pool is not rescanned from slot 0. */
+int enemy_alloc_batch(Game *g, int *out, int n) {
+  int got = 0;
+  int cursor = g->enemy_alloc_cursor;
+  if (cursor < 0 || cursor >= g->caps.enemies) cursor = 0;
+  for (int k = 0; k < g->caps.enemies && got < n; k++) {
+    int i = cursor + k;
+    if (i >= g->caps.enemies) i -= g->caps.enemies;
+    if (g->enemies[i].active) continue;
+    out[got++] = i;
+    g->enemy_alloc_cursor = i + 1 < g->caps.enemies ? i + 1 : 0;
+  }
+  return got;
+}
+
+void enemy_init(Game *g, int slot, int def_index, float x, float y) {
+  Enemy *e = &g->enemies[slot];
+  unsigned int gen = e->gen;
+  memset(e, 0, sizeof(*e));
+  e->active = 1;
+  e->gen = gen + 1;
+  hit_sets_forget_enemy(g, slot);
+  e->def_index = def_index;
+  EnemyDef *def = &g->db.enemies[def_index];
+  e->hp = def->hp;
+  e->max_hp = def->hp;
+  debuffs_clear(g, slot);
+  debuff_apply(g, e, DEBUFF_SPAWN_INVULN, 1.0f);
+  e->hit_timer = -1.0f;
+  e->x = x;
+  e->y = y;
+}
+
 void spawn_enemy(Game *g, int def_index) {
-  for (int i = 0; i < MAX_ENEMIES; i++) {
-    if (!g->enemies[i].active) {
-      Enemy *e = &g->enemies[i];
-      memset(e, 0, sizeof(*e));
-      e->active = 1;
-      e->def_index = def_index;
-      EnemyDef *def = &g->db.enemies[def_index];
-      e->hp = def->hp;
-      e->max_hp = def->hp;
-      e->spawn_invuln = 1.0f;
-      e->hit_timer = -1.0f;
-      float x = 0.0f;
-      float y = 0.0f;
-      float margin = 20.0f;
-      float cam_min_x = g->camera_x;
-      float cam_max_x = g->camera_x + g->view_w;
-      float cam_min_y = g->camera_y;
-      float cam_max_y = g->camera_y + g->view_h;
-      int side = rand() % 4;
-      if (side == 0) {
-        x = cam_min_x - margin;
-        y = cam_min_y + frandf() * g->view_h;
-      } else if (side == 1) {
-        x = cam_max_x + margin;
-        y = cam_min_y + frandf() * g->view_h;
-      } else if (side == 2) {
-        x = cam_min_x + frandf() * g->view_w;
-        y = cam_min_y - margin;
-      } else {
-        x = cam_min_x + frandf() * g->view_w;
-        y = cam_max_y + margin;
-      }
-      x = clampf(x, 40.0f, ARENA_W - 40.0f);
-      y = clampf(y, 40.0f, ARENA_H - 40.0f);
-      e->x = x;
-      e->y = y;
-      return;
+  spawn_enemy_batch(g, &def_index, 1, SPAWN_EDGE, 1);
+}
+
+/* Enemies farther from the player tick every 2^bucket frames with the
+   skipped dt folded in, staggered by slot so each frame does a similar share. */
+static int enemy_lod_bucket(float dist2) {
+  if (dist2 < ENEMY_LOD_NEAR * ENEMY_LOD_NEAR) return 0;
+  if (dist2 < ENEMY_LOD_MID * ENEMY_LOD_MID) return 1;
+  if (dist2 < ENEMY_LOD_FAR * ENEMY_LOD_FAR) return 2;
+  return 3;
+}
+
+static void enemy_die(Game *g, Enemy *e, Stats *stats) {
+  Player *p = &g->player;
+  e->active = 0;
+  g->kills += 1;
+  if (!debuff_active(g, e, DEBUFF_SPAWN_INVULN)) {
+    float lifesteal = player_lifesteal_on_kill(p, &g->db);
+    if (lifesteal > 0.0f && p->alch_ult_phase == 0) {
+      p->hp = clampf(p->hp + lifesteal, 0.0f, stats->max_hp);
+      log_combatf(g, "lifesteal_on_kill +%.1f HP", lifesteal);
     }
+    spawn_drop(g, e->x, e->y, 0, 1 + rand() % 2);
+    if (frandf() < 0.05f) spawn_drop(g, e->x, e->y, 1, 10 + rand() % 10);
   }
 }
 
 void update_enemies(Game *g, float dt) {
   Player *p = &g->player;
   Stats stats = player_total_stats(p, &g->db);
-  for (int i = 0; i < MAX_ENEMIES; i++) {
+  unsigned int tick = g->enemy_lod_tick++;
+  memset(g->enemy_lod_counts, 0, sizeof(g->enemy_lod_counts));
+  g->enemy_lod_updates = 0;
+  for (int i = 0; i < g->caps.enemies; i++) {
     Enemy *e = &g->enemies[i];
     if (!e->active) continue;
     EnemyDef *def = &g->db.enemies[e->def_index];
     float dx = p->x - e->x;
     float dy = p->y - e->y;
     float dist2 = dx * dx + dy * dy;
-    float dist = sqrtf(dist2);
-
-    if (e->spawn_invuln > 0.0f) e->spawn_invuln -= dt;
-    if (e->debuffs.burn_timer > 0.0f) {
-      e->debuffs.burn_timer -= dt;
-      e->hp -= 4.0f * dt;
-    }
-    if (e->debuffs.bleed_timer > 0.0f) {
-      e->debuffs.bleed_timer -= dt;
-      e->hp -= e->debuffs.bleed_stacks * 1.5f * dt;
-      if (e->debuffs.bleed_timer <= 0.0f) e->debuffs.bleed_stacks = 0;
-    }
-    if (e->debuffs.slow_timer > 0.0f) e->debuffs.slow_timer -= dt;
-    if (e->debuffs.stun_timer > 0.0f) e->debuffs.stun_timer -= dt;
-    if (e->debuffs.armor_shred_timer > 0.0f) e->debuffs.armor_shred_timer -= dt;
-    if (e->debuffs.molten_tick_cd > 0.0f) e->debuffs.molten_tick_cd -= dt;
-    if (e->debuffs.curse_timer > 0.0f) {
-      e->debuffs.curse_timer -= dt;
-      e->hp -= e->debuffs.curse_dps * dt;
-      if (e->debuffs.curse_timer < 0.0f) e->debuffs.curse_timer = 0.0f;
-    }
-    if (e->sword_hit_cd > 0.0f) e->sword_hit_cd -= dt;
 
-    float aura_range = player_slow_aura(p, &g->db);
-    if (aura_range > 0.0f && dist < aura_range) {
-      e->debuffs.slow_timer = 0.5f;
-    }
-
-    float burn_range = player_burn_aura(p, &g->db);
-    if (burn_range > 0.0f && dist < burn_range) {
-      if (e->debuffs.burn_timer <= 0.0f) {
-        log_combatf(g, "burn_aura applied to %s", enemy_label(g, e));
-      }
-      e->debuffs.burn_timer = 0.5f;
+    int bucket = enemy_lod_bucket(dist2);
+    g->enemy_lod_counts[bucket]++;
+    e->lod_dt += dt;
+    unsigned int period = 1u << bucket;
+    if (((tick + (unsigned int)i) & (period - 1u)) != 0) {
+      /* Weapons can still kill a skipped enemy; don't hold its death back. */
+      if (e->hp <= 0.0f) enemy_die(g, e, &stats);
+      continue;
     }
+    float step = e->lod_dt;
+    e->lod_dt = 0.0f;
+    g->enemy_lod_updates++;
+    float dist = sqrtf(dist2);
+    /* Slow and burn auras are stamped into the damage field in update_puddles. */
+    int stunned = debuff_active(g, e, DEBUFF_STUN);
 
-    if (e->debuffs.stun_timer <= 0.0f &&
+    if (!stunned &&
         (strcmp(def->role, "ranged") == 0 || strcmp(def->role, "boss") == 0 || strcmp(def->role, "turret") == 0)) {
-      e->cooldown -= dt;
+      e->cooldown -= step;
       if (e->cooldown <= 0.0f) {
         float vx = dx;
         float vy = dy;
         vec_norm(&vx, &vy);
-        spawn_bullet(g, e->x, e->y, vx * def->projectile_speed, vy * def->projectile_speed, def->damage, 0, 0, 0,
-                     -1, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        spawn_enemy_bullet(g, e->x, e->y, vx * def->projectile_speed, vy * def->projectile_speed, def->damage);
         e->cooldown = def->cooldown;
       }
     }
 
-    if (e->debuffs.stun_timer <= 0.0f && strcmp(def->role, "charger") == 0) {
-      e->charge_timer -= dt;
+    if (!stunned && strcmp(def->role, "charger") == 0) {
+      e->charge_timer -= step;
       if (e->charge_timer <= 0.0f) {
         float vx = dx;
         float vy = dy;
@@ -121,24 +129,24 @@ void update_enemies(Game *g, float dt) {
       }
     }
 
-    if (e->debuffs.stun_timer <= 0.0f && strcmp(def->role, "turret") != 0) {
+    if (!stunned && strcmp(def->role, "turret") != 0) {
       if (e->charge_time > 0.0f) {
-        e->x += e->vx * dt;
-        e->y += e->vy * dt;
-        e->charge_time -= dt;
+        e->x += e->vx * step;
+        e->y += e->vy * step;
+        e->charge_time -= step;
       } else {
         float vx = dx;
         float vy = dy;
         vec_norm(&vx, &vy);
-        float slow_mul = (e->debuffs.slow_timer > 0.0f) ? 0.5f : 1.0f;
-        e->x += vx * def->speed * slow_mul * dt;
-        e->y += vy * def->speed * slow_mul * dt;
+        float slow_mul = debuff_active(g, e, DEBUFF_SLOW) ? 0.5f : 1.0f;
+        e->x += vx * def->speed * slow_mul * step;
+        e->y += vy * def->speed * slow_mul * step;
       }
     }
 
     if (dist < 20.0f && p->alch_ult_phase == 0) { 
       float dmg = damage_after_armor(def->damage, stats.armor); 
-      float applied = player_damage_reduce(g, dmg * dt); 
+      float applied = player_damage_reduce(g, dmg * step); 
       p->hp -= applied; 
       float thorns = player_thorns_percent(p, &g->db); 
       if (thorns > 0.0f) { 
@@ -159,18 +167,6 @@ void update_enemies(Game *g, float dt) {
       e->hp = 0;
     }
 
-    if (e->hp <= 0.0f) {
-      e->active = 0;
-      g->kills += 1;
-      if (e->spawn_invuln <= 0.0f) {
-        float lifesteal = player_lifesteal_on_kill(p, &g->db);
-        if (lifesteal > 0.0f && p->alch_ult_phase == 0) {
-          p->hp = clampf(p->hp + lifesteal, 0.0f, stats.max_hp);
-          log_combatf(g, "lifesteal_on_kill +%.1f HP", lifesteal);
-        }
-        spawn_drop(g, e->x, e->y, 0, 1 + rand() % 2);
-        if (frandf() < 0.05f) spawn_drop(g, e->x, e->y, 1, 10 + rand() % 10);
-      }
-    }
+    if (e->hp <= 0.0f) enemy_die(g, e, &stats);
   }
 }
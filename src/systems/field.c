@@ -0,0 +1,172 @@
+#include "systems/field.h"
+
+#include "systems/debuffs.h"
+#include "systems/enemies.h"
+
+#define FIELD_TOUCHED 1u
+#define FIELD_SLOW 2u
+#define FIELD_BURN 4u
+
+#define FIELD_SRC_SLOW_AURA MAX_PUDDLES
+#define FIELD_SRC_BURN_AURA (MAX_PUDDLES + 1)
+
+/* Fixed-size grids, allocated once by game_pools_init before any tick runs. */
+int damage_field_reserve(DamageField *f) {
+  const size_t cells = (size_t)FIELD_COLS * FIELD_ROWS;
+  if (f->dps) return 1;
+  alloc_guard_note("damage field");
+  f->dps = calloc(cells, sizeof(float));
+  f->molten_dps = calloc(cells, sizeof(float));
+  f->flags = calloc(cells, 1);
+  f->edge_head = calloc(cells, sizeof(int));
+  f->touched = malloc(cells * sizeof(int));
+  f->edge_src = malloc(FIELD_EDGE_CAP * sizeof(int));
+  f->edge_next = malloc(FIELD_EDGE_CAP * sizeof(int));
+  if (!f->dps || !f->molten_dps || !f->flags || !f->edge_head || !f->touched || !f->edge_src || !f->edge_next) {
+    log_line("Damage field allocation failed");
+    damage_field_free(f);
+    return 0;
+  }
+  return 1;
+}
+
+void damage_field_free(DamageField *f) {
+  free(f->dps);
+  free(f->molten_dps);
+  free(f->flags);
+  free(f->edge_head);
+  free(f->touched);
+  free(f->edge_src);
+  free(f->edge_next);
+  memset(f, 0, sizeof(*f));
+}
+
+static void field_touch(DamageField *f, int cell) {
+  if (f->flags[cell] & FIELD_TOUCHED) return;
+  f->flags[cell] |= FIELD_TOUCHED;
+  f->touched[f->touched_count++] = cell;
+}
+
+/* Stamps a circle: cells it fully covers take its dps or status directly,
+   cells it partly covers get an edge entry pointing back at the source. */
+static void field_stamp_circle(DamageField *f, float cx, float cy, float r, int src, float dps, int molten,
+                               unsigned char status) {
+  if (r <= 0.0f) return;
+  int c0 = (int)floorf((cx - r) / FIELD_CELL);
+  int c1 = (int)floorf((cx + r) / FIELD_CELL);
+  int r0 = (int)floorf((cy - r) / FIELD_CELL);
+  int r1 = (int)floorf((cy + r) / FIELD_CELL);
+  if (c0 < 0) c0 = 0;
+  if (r0 < 0) r0 = 0;
+  if (c1 >= FIELD_COLS) c1 = FIELD_COLS - 1;
+  if (r1 >= FIELD_ROWS) r1 = FIELD_ROWS - 1;
+  float r2 = r * r;
+  for (int row = r0; row <= r1; row++) {
+    float y0 = (float)(row * FIELD_CELL);
+    float y1 = y0 + FIELD_CELL;
+    float ny = clampf(cy, y0, y1) - cy;
+    float fy = fmaxf(fabsf(y0 - cy), fabsf(y1 - cy));
+    for (int col = c0; col <= c1; col++) {
+      float x0 = (float)(col * FIELD_CELL);
+      float x1 = x0 + FIELD_CELL;
+      float nx = clampf(cx, x0, x1) - cx;
+      if (nx * nx + ny * ny > r2) continue;
+      float fx = fmaxf(fabsf(x0 - cx), fabsf(x1 - cx));
+      int cell = row * FIELD_COLS + col;
+      field_touch(f, cell);
+      if (fx * fx + fy * fy <= r2) {
+        if (molten) f->molten_dps[cell] = fmaxf(f->molten_dps[cell], dps);
+        else f->dps[cell] += dps;
+        f->flags[cell] |= status;
+      } else if (f->edge_count < FIELD_EDGE_CAP) {
+        f->edge_src[f->edge_count] = src;
+        f->edge_next[f->edge_count] = f->edge_head[cell];
+        f->edge_head[cell] = ++f->edge_count;
+      }
+    }
+  }
+}
+
+/* Clears last tick's cells and stamps live puddles and the player's auras.
+   Returns 0 when there is nothing to sample. */
+int damage_field_build(Game *g) {
+  DamageField *f = &g->field;
+  if (!damage_field_reserve(f)) return 0;
+  for (int i = 0; i < f->touched_count; i++) {
+    int cell = f->touched[i];
+    f->dps[cell] = 0.0f;
+    f->molten_dps[cell] = 0.0f;
+    f->flags[cell] = 0;
+    f->edge_head[cell] = 0;
+  }
+  f->touched_count = 0;
+  f->edge_count = 0;
+  f->log_due = 0;
+  for (int i = 0; i < MAX_PUDDLES; i++) {
+    const Puddle *p = &g->puddles[i];
+    if (!p->active) continue;
+    field_stamp_circle(f, p->x, p->y, p->radius, i, p->dps, p->kind == 2, 0);
+    if (p->log_timer <= 0.0f) f->log_due = 1;
+  }
+  Player *pl = &g->player;
+  field_stamp_circle(f, pl->x, pl->y, player_slow_aura(pl, &g->db), FIELD_SRC_SLOW_AURA, 0.0f, 0, FIELD_SLOW);
+  field_stamp_circle(f, pl->x, pl->y, player_burn_aura(pl, &g->db), FIELD_SRC_BURN_AURA, 0.0f, 0, FIELD_BURN);
+  return f->touched_count > 0;
+}
+
+static int field_cell_of(float x, float y) {
+  int col = (int)floorf(x / FIELD_CELL);
+  int row = (int)floorf(y / FIELD_CELL);
+  if (col < 0 || col >= FIELD_COLS || row < 0 || row >= FIELD_ROWS) return -1;
+  return row * FIELD_COLS + col;
+}
+
+/* One lookup per enemy: the cell's accumulated values plus exact tests
+   against the sources that only partly cover it. */
+void damage_field_apply(Game *g, float dt) {
+  DamageField *f = &g->field;
+  if (!f->dps || f->touched_count == 0) return;
+  Player *pl = &g->player;
+  float slow_r = player_slow_aura(pl, &g->db);
+  float burn_r = player_burn_aura(pl, &g->db);
+  for (int e = 0; e < g->caps.enemies; e++) {
+    Enemy *en = &g->enemies[e];
+    if (!en->active) continue;
+    int cell = field_cell_of(en->x, en->y);
+    if (cell < 0 || !(f->flags[cell] & FIELD_TOUCHED)) continue;
+    float dps = f->dps[cell];
+    float molten = f->molten_dps[cell];
+    unsigned char status = f->flags[cell];
+    for (int k = f->edge_head[cell]; k; k = f->edge_next[k - 1]) {
+      int src = f->edge_src[k - 1];
+      float cx = pl->x, cy = pl->y, r;
+      if (src == FIELD_SRC_SLOW_AURA) r = slow_r;
+      else if (src == FIELD_SRC_BURN_AURA) r = burn_r;
+      else {
+        cx = g->puddles[src].x;
+        cy = g->puddles[src].y;
+        r = g->puddles[src].radius;
+      }
+      float dx = en->x - cx;
+      float dy = en->y - cy;
+      if (dx * dx + dy * dy > r * r) continue;
+      if (src == FIELD_SRC_SLOW_AURA) status |= FIELD_SLOW;
+      else if (src == FIELD_SRC_BURN_AURA) status |= FIELD_BURN;
+      else if (g->puddles[src].kind == 2) molten = fmaxf(molten, g->puddles[src].dps);
+      else dps += g->puddles[src].dps;
+    }
+    if (status & FIELD_SLOW) debuff_apply(g, en, DEBUFF_SLOW, 0.5f);
+    if (status & FIELD_BURN) {
+      if (!debuff_active(g, en, DEBUFF_BURN)) log_combatf(g, "burn_aura applied to %s", enemy_label(g, en));
+      debuff_apply(g, en, DEBUFF_BURN, 0.5f);
+    }
+    if (debuff_active(g, en, DEBUFF_SPAWN_INVULN)) continue;
+    if (molten > 0.0f && debuff_active(g, en, DEBUFF_MOLTEN_CD)) molten = 0.0f;
+    float dmg = (dps + molten) * dt;
+    if (dmg <= 0.0f) continue;
+    mark_enemy_hit(en);
+    en->hp -= dmg;
+    if (molten > 0.0f) debuff_apply(g, en, DEBUFF_MOLTEN_CD, 0.25f);
+    if (f->log_due) log_combatf(g, "puddle tick %s for %.1f", enemy_label(g, en), dmg);
+  }
+}
@@ -0,0 +1,90 @@
+#include "systems/hits.h"
+
+#include "core/pools.h"
+
+static unsigned int hit_key(const Game *g, int enemy) {
+  return (unsigned int)enemy | (g->enemies[enemy].gen << 16);
+}
+
+static void overflow_release(Game *g, HitSet *s) {
+  if (s->overflow > 0) g->hit_overflow[s->overflow - 1].in_use = 0;
+  s->overflow = 0;
+}
+
+/* Bullets and effects are switched off in many places without touching
+   their sets, so pool entries held by dead owners are reclaimed on demand. */
+static void overflow_reclaim(Game *g) {
+  for (int i = 0; i < g->caps.bullets; i++) {
+    if (!g->bullets[i].active) overflow_release(g, &g->bullets[i].hits);
+  }
+  for (int i = 0; i < MAX_WEAPON_FX; i++) {
+    if (!g->weapon_fx[i].active) overflow_release(g, &g->weapon_fx[i].hits);
+  }
+}
+
+static int overflow_alloc(Game *g) {
+  for (int pass = 0; pass < 2; pass++) {
+    for (int i = 0; i < MAX_HIT_OVERFLOW; i++) {
+      HitOverflow *o = &g->hit_overflow[i];
+      if (o->in_use) continue;
+      o->in_use = 1;
+      memset(o->bits, 0, sizeof(*o->bits) * (size_t)hit_overflow_words(g));
+      return i + 1;
+    }
+    overflow_reclaim(g);
+  }
+  return 0;
+}
+
+/* Drops every pool reference; live sets keep their inline entries. Used
+   when projectiles are wiped or restored from a snapshot. */
+void hit_sets_reset(Game *g) {
+  for (int i = 0; i < MAX_HIT_OVERFLOW; i++) g->hit_overflow[i].in_use = 0;
+  for (int i = 0; i < g->caps.bullets; i++) g->bullets[i].hits.overflow = 0;
+  for (int i = 0; i < MAX_WEAPON_FX; i++) g->weapon_fx[i].hits.overflow = 0;
+}
+
+/* A reused slot must not inherit the old occupant's bitmap bits. Inline
+   keys carry the generation and go stale on their own. */
+void hit_sets_forget_enemy(Game *g, int enemy) {
+  for (int i = 0; i < MAX_HIT_OVERFLOW; i++) {
+    if (g->hit_overflow[i].in_use) g->hit_overflow[i].bits[enemy >> 5] &= ~(1u << (enemy & 31));
+  }
+}
+
+void hit_set_clear(Game *g, HitSet *s) {
+  overflow_release(g, s);
+  s->count = 0;
+  s->ring = 0;
+}
+
+int hit_set_contains(const Game *g, const HitSet *s, int enemy) {
+  unsigned int key = hit_key(g, enemy);
+  for (int i = 0; i < s->count; i++) {
+    if (s->keys[i] == key) return 1;
+  }
+  if (s->overflow > 0) {
+    const HitOverflow *o = &g->hit_overflow[s->overflow - 1];
+    return (o->bits[enemy >> 5] >> (enemy & 31)) & 1u;
+  }
+  return 0;
+}
+
+/* Returns 1 if the enemy was newly added, 0 if it was already present. */
+int hit_set_add(Game *g, HitSet *s, int enemy) {
+  if (hit_set_contains(g, s, enemy)) return 0;
+  if (s->count < HIT_SET_INLINE) {
+    s->keys[s->count++] = hit_key(g, enemy);
+    return 1;
+  }
+  if (s->overflow == 0) s->overflow = (short)overflow_alloc(g);
+  if (s->overflow > 0) {
+    HitOverflow *o = &g->hit_overflow[s->overflow - 1];
+    o->bits[enemy >> 5] |= 1u << (enemy & 31);
+    return 1;
+  }
+  /* Pool exhausted: forget the oldest inline entry rather than fail. */
+  s->keys[s->ring] = hit_key(g, enemy);
+  s->ring = (unsigned char)((s->ring + 1) % HIT_SET_INLINE);
+  return 1;
+}
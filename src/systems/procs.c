@@ -0,0 +1,57 @@
+#include "systems/procs.h"
+
+#include "systems/enemies.h"
+#include "systems/spatial.h"
+
+/* Each chain gets a fresh stamp, so visited marks never need clearing
+   except when the counter wraps. */
+static unsigned int chain_next_stamp(Game *g) {
+  if (++g->chain_stamp == 0) {
+    memset(g->chain_mark, 0, sizeof(*g->chain_mark) * (size_t)g->caps.enemies);
+    g->chain_stamp = 1;
+  }
+  return g->chain_stamp;
+}
+
+static void chain_resolve(Game *g, const ChainProc *c) {
+  if (c->bounces <= 0 || c->range <= 0.0f) return;
+  if (g->enemies[c->start].gen != c->start_gen) return;
+  unsigned int stamp = chain_next_stamp(g);
+  g->chain_mark[c->start] = stamp;
+  int current = c->start;
+  for (int b = 0; b < c->bounces; b++) {
+    int next = enemy_grid_nearest_unmarked(g, g->enemies[current].x, g->enemies[current].y, c->range, g->chain_mark,
+                                           stamp);
+    if (next < 0) break;
+    Enemy *en = &g->enemies[next];
+    mark_enemy_hit(en);
+    float hit = player_apply_hit_mods(g, en, c->damage);
+    en->hp -= hit;
+    log_combatf(g, "chain_lightning hit %s for %.1f", enemy_label(g, en), hit);
+    g->chain_mark[next] = stamp;
+    current = next;
+  }
+}
+
+void procs_queue_chain(Game *g, int start, float damage, int bounces, float range) {
+  if (start < 0 || start >= g->caps.enemies) return;
+  if (g->chain_proc_count >= MAX_CHAIN_PROCS) procs_flush(g);
+  ChainProc *c = &g->chain_procs[g->chain_proc_count++];
+  c->start = start;
+  c->start_gen = g->enemies[start].gen;
+  c->damage = damage;
+  c->bounces = bounces;
+  c->range = range;
+}
+
+/* Resolves every chain queued this tick against a freshly built grid. */
+void procs_flush(Game *g) {
+  if (g->chain_proc_count == 0) return;
+  enemy_grid_build(g);
+  for (int i = 0; i < g->chain_proc_count; i++) chain_resolve(g, &g->chain_procs[i]);
+  g->chain_proc_count = 0;
+}
+
+void procs_clear(Game *g) {
+  g->chain_proc_count = 0;
+}
@@ -0,0 +1,94 @@
+#include "systems/projectiles.h"
+
+#include "core/simd.h"
+
+/* Returns a slot at the tail, or -1 when every slot is still in flight. */
+int bullet_ring_alloc(Game *g) {
+  BulletRing *r = &g->bullet_ring;
+  if (bullet_ring_count(r) > (int)r->mask) bullet_ring_retire(g);
+  if (bullet_ring_count(r) > (int)r->mask) return -1;
+  return (int)(r->tail++ & r->mask);
+}
+
+/* Pops dead shots off the head. Shots that pierced out early leave holes
+   behind the head; they are reclaimed once everything older has expired. */
+void bullet_ring_retire(Game *g) {
+  BulletRing *r = &g->bullet_ring;
+  while (r->head != r->tail && !g->bullets[r->head & r->mask].active) r->head++;
+}
+
+/* Copies slot data between two rings of the same capacity. */
+void bullet_ring_copy(BulletRing *dst, const BulletRing *src) {
+  size_t n = (size_t)src->mask + 1;
+  memcpy(dst->x, src->x, n * sizeof(float));
+  memcpy(dst->y, src->y, n * sizeof(float));
+  memcpy(dst->px, src->px, n * sizeof(float));
+  memcpy(dst->py, src->py, n * sizeof(float));
+  memcpy(dst->vx, src->vx, n * sizeof(float));
+  memcpy(dst->vy, src->vy, n * sizeof(float));
+  memcpy(dst->life, src->life, n * sizeof(float));
+  memcpy(dst->flags, src->flags, n);
+  dst->head = src->head;
+  dst->tail = src->tail;
+}
+
+void bullets_clear(Game *g) {
+  for (int i = 0; i < g->caps.bullets; i++) g->bullets[i].active = 0;
+  g->bullet_ring.head = 0;
+  g->bullet_ring.tail = 0;
+  g->enemy_bullet_count = 0;
+}
+
+static void integrate_scalar(BulletRing *r, int i, float dt) {
+  r->px[i] = r->x[i];
+  r->py[i] = r->y[i];
+  r->x[i] += r->vx[i] * dt;
+  r->y[i] += r->vy[i] * dt;
+  r->life[i] -= dt;
+  r->flags[i] = (unsigned char)((r->life[i] <= 0.0f ? BULLET_EXPIRED : 0) |
+                                (r->x[i] < 0.0f || r->x[i] > ARENA_W || r->y[i] < 0.0f || r->y[i] > ARENA_H
+                                     ? BULLET_OUTSIDE
+                                     : 0));
+}
+
+static void integrate_span(BulletRing *r, int begin, int end, float dt) {
+  int i = begin;
+#ifdef BUH_SSE2
+  const __m128 vdt = _mm_set1_ps(dt);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 max_x = _mm_set1_ps((float)ARENA_W);
+  const __m128 max_y = _mm_set1_ps((float)ARENA_H);
+  for (; i + 4 <= end; i += 4) {
+    __m128 x = _mm_loadu_ps(&r->x[i]);
+    __m128 y = _mm_loadu_ps(&r->y[i]);
+    _mm_storeu_ps(&r->px[i], x);
+    _mm_storeu_ps(&r->py[i], y);
+    x = _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(&r->vx[i]), vdt));
+    y = _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(&r->vy[i]), vdt));
+    __m128 life = _mm_sub_ps(_mm_loadu_ps(&r->life[i]), vdt);
+    _mm_storeu_ps(&r->x[i], x);
+    _mm_storeu_ps(&r->y[i], y);
+    _mm_storeu_ps(&r->life[i], life);
+    int expired = _mm_movemask_ps(_mm_cmple_ps(life, zero));
+    __m128 out = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(x, zero), _mm_cmpgt_ps(x, max_x)),
+                           _mm_or_ps(_mm_cmplt_ps(y, zero), _mm_cmpgt_ps(y, max_y)));
+    int outside = _mm_movemask_ps(out);
+    for (int k = 0; k < 4; k++) {
+      r->flags[i + k] = (unsigned char)(((expired >> k) & 1) * BULLET_EXPIRED | ((outside >> k) & 1) * BULLET_OUTSIDE);
+    }
+  }
+#endif
+  for (; i < end; i++) integrate_scalar(r, i, dt);
+}
+
+/* Moves, bounds-checks and ages every slot between head and tail in one
+   pass, dead holes included; collision code reads the flags afterwards. */
+void bullet_ring_integrate(BulletRing *r, float dt) {
+  int n = bullet_ring_count(r);
+  if (n <= 0) return;
+  int cap = (int)r->mask + 1;
+  int start = (int)(r->head & r->mask);
+  int first = n < cap - start ? n : cap - start;
+  integrate_span(r, start, start + first, dt);
+  integrate_span(r, 0, n - first, dt);
+}
@@ -0,0 +1,76 @@
+#include "systems/queries.h"
+
+typedef enum { SHAPE_SECTOR, SHAPE_OBB, SHAPE_CAPSULE, SHAPE_RING } ShapeKind;
+
+typedef struct {
+  ShapeKind kind;
+  float a[8];
+} Shape;
+
+static int shape_contains(const Shape *s, float x, float y) {
+  const float *a = s->a;
+  switch (s->kind) {
+  case SHAPE_SECTOR: return geom_in_sector(x, y, a[0], a[1], a[2], a[3], a[4], a[5]);
+  case SHAPE_OBB: return geom_in_obb(x, y, a[0], a[1], a[2], a[3], a[4], a[5]);
+  case SHAPE_CAPSULE: return geom_in_capsule(x, y, a[0], a[1], a[2], a[3], a[4]);
+  case SHAPE_RING: return geom_in_ring(x, y, a[0], a[1], a[2], a[3]);
+  }
+  return 0;
+}
+
+static int clamp_cell(float v, int count) {
+  int c = (int)floorf(v / (float)ENEMY_GRID_CELL);
+  if (c < 0) return 0;
+  if (c >= count) return count - 1;
+  return c;
+}
+
+/* Walks the cells under [min, max] (padded for enemies nudged since the
+   grid was built) and keeps the enemies the shape contains. */
+static int query_bounds(const Game *g, const Shape *s, float min_x, float min_y, float max_x, float max_y, int *out,
+                        int max_out) {
+  const EnemyGrid *grid = &g->enemy_grid;
+  int c0 = clamp_cell(min_x - ENEMY_GRID_SLACK, ENEMY_GRID_COLS);
+  int c1 = clamp_cell(max_x + ENEMY_GRID_SLACK, ENEMY_GRID_COLS);
+  int r0 = clamp_cell(min_y - ENEMY_GRID_SLACK, ENEMY_GRID_ROWS);
+  int r1 = clamp_cell(max_y + ENEMY_GRID_SLACK, ENEMY_GRID_ROWS);
+  int n = 0;
+  for (int r = r0; r <= r1; r++) {
+    for (int c = c0; c <= c1; c++) {
+      int cell = r * ENEMY_GRID_COLS + c;
+      for (int k = grid->cell_start[cell]; k < grid->cell_start[cell + 1]; k++) {
+        int idx = grid->items[k];
+        const Enemy *en = &g->enemies[idx];
+        if (!en->active || !shape_contains(s, en->x, en->y)) continue;
+        if (n >= max_out) return n;
+        out[n++] = idx;
+      }
+    }
+  }
+  return n;
+}
+
+int enemy_query_sector(const Game *g, float ox, float oy, float dx, float dy, float range, float cos_half, int *out,
+                       int max_out) {
+  Shape s = {SHAPE_SECTOR, {ox, oy, dx, dy, range, cos_half}};
+  return query_bounds(g, &s, ox - range, oy - range, ox + range, oy + range, out, max_out);
+}
+
+int enemy_query_obb(const Game *g, float cx, float cy, float ux, float uy, float half_len, float half_w, int *out,
+                    int max_out) {
+  Shape s = {SHAPE_OBB, {cx, cy, ux, uy, half_len, half_w}};
+  float ex = fabsf(ux) * half_len + fabsf(uy) * half_w;
+  float ey = fabsf(uy) * half_len + fabsf(ux) * half_w;
+  return query_bounds(g, &s, cx - ex, cy - ey, cx + ex, cy + ey, out, max_out);
+}
+
+int enemy_query_capsule(const Game *g, float x0, float y0, float x1, float y1, float radius, int *out, int max_out) {
+  Shape s = {SHAPE_CAPSULE, {x0, y0, x1, y1, radius}};
+  return query_bounds(g, &s, fminf(x0, x1) - radius, fminf(y0, y1) - radius, fmaxf(x0, x1) + radius,
+                      fmaxf(y0, y1) + radius, out, max_out);
+}
+
+int enemy_query_ring(const Game *g, float cx, float cy, float r_inner, float r_outer, int *out, int max_out) {
+  Shape s = {SHAPE_RING, {cx, cy, r_inner, r_outer}};
+  return query_bounds(g, &s, cx - r_outer, cy - r_outer, cx + r_outer, cy + r_outer, out, max_out);
+}
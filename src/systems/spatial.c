@@ -0,0 +1,146 @@
+#include "systems/spatial.h"
+
+static int grid_col(float x) {
+  int c = (int)(x / (float)ENEMY_GRID_CELL);
+  if (c < 0) return 0;
+  if (c >= ENEMY_GRID_COLS) return ENEMY_GRID_COLS - 1;
+  return c;
+}
+
+static int grid_row(float y) {
+  int r = (int)(y / (float)ENEMY_GRID_CELL);
+  if (r < 0) return 0;
+  if (r >= ENEMY_GRID_ROWS) return ENEMY_GRID_ROWS - 1;
+  return r;
+}
+
+/* Counting sort by cell. Filling back to front leaves each cell's
+   enemies in ascending slot order, so queries stay deterministic. */
+void enemy_grid_build(Game *g) {
+  EnemyGrid *grid = &g->enemy_grid;
+  const int cells = ENEMY_GRID_COLS * ENEMY_GRID_ROWS;
+  memset(grid->cell_start, 0, sizeof(grid->cell_start));
+  int count = 0;
+  for (int i = 0; i < g->caps.enemies; i++) {
+    const Enemy *e = &g->enemies[i];
+    if (!e->active) continue;
+    grid->cell_start[grid_row(e->y) * ENEMY_GRID_COLS + grid_col(e->x)]++;
+    count++;
+  }
+  for (int c = 1; c < cells; c++) grid->cell_start[c] += grid->cell_start[c - 1];
+  grid->cell_start[cells] = count;
+  for (int i = g->caps.enemies - 1; i >= 0; i--) {
+    const Enemy *e = &g->enemies[i];
+    if (!e->active) continue;
+    int c = grid_row(e->y) * ENEMY_GRID_COLS + grid_col(e->x);
+    grid->items[--grid->cell_start[c]] = i;
+  }
+  grid->count = count;
+}
+
+/* Earliest t in [0, 1] where the segment comes within r of the center.
+   A segment that starts inside the circle hits at t = 0. */
+int segment_circle_hit(float x0, float y0, float x1, float y1, float cx, float cy, float r, float *out_t) {
+  float dx = x1 - x0;
+  float dy = y1 - y0;
+  float fx = x0 - cx;
+  float fy = y0 - cy;
+  float c = fx * fx + fy * fy - r * r;
+  if (c <= 0.0f) {
+    *out_t = 0.0f;
+    return 1;
+  }
+  float a = dx * dx + dy * dy;
+  if (a <= 1e-8f) return 0;
+  float b = fx * dx + fy * dy;
+  if (b >= 0.0f) return 0; /* moving away */
+  float disc = b * b - a * c;
+  if (disc < 0.0f) return 0;
+  float t = (-b - sqrtf(disc)) / a;
+  if (t > 1.0f) return 0;
+  *out_t = t < 0.0f ? 0.0f : t;
+  return 1;
+}
+
+/* Enemies touched by a circle of `radius` moving from (x0,y0) to (x1,y1),
+   sorted by contact time. Returns the number written to out. */
+int enemy_grid_sweep(const Game *g, float x0, float y0, float x1, float y1, float radius, SweepHit *out, int max_hits) {
+  const EnemyGrid *grid = &g->enemy_grid;
+  float reach = radius + ENEMY_RADIUS;
+  int c0 = grid_col(fminf(x0, x1) - reach);
+  int c1 = grid_col(fmaxf(x0, x1) + reach);
+  int r0 = grid_row(fminf(y0, y1) - reach);
+  int r1 = grid_row(fmaxf(y0, y1) + reach);
+  int n = 0;
+  for (int r = r0; r <= r1; r++) {
+    for (int c = c0; c <= c1; c++) {
+      int cell = r * ENEMY_GRID_COLS + c;
+      for (int k = grid->cell_start[cell]; k < grid->cell_start[cell + 1]; k++) {
+        int idx = grid->items[k];
+        const Enemy *en = &g->enemies[idx];
+        if (!en->active) continue;
+        float t;
+        if (!segment_circle_hit(x0, y0, x1, y1, en->x, en->y, reach, &t)) continue;
+        /* Insertion keeps the list in travel order; ties go to the lower slot. */
+        int pos = n < max_hits ? n : max_hits;
+        while (pos > 0 && (out[pos - 1].t > t || (out[pos - 1].t == t && out[pos - 1].enemy > idx))) pos--;
+        if (pos >= max_hits) continue;
+        int last = n < max_hits ? n : max_hits - 1;
+        for (int m = last; m > pos; m--) out[m] = out[m - 1];
+        out[pos].enemy = idx;
+        out[pos].t = t;
+        if (n < max_hits) n++;
+      }
+    }
+  }
+  return n;
+}
+
+/* Nearest active enemy within max_dist of (x, y), or -1. Scans rings of
+   cells outward and stops once no farther ring can hold anything closer.
+   Enemies whose mark equals stamp are skipped when marks is given. */
+static int grid_nearest(const Game *g, float x, float y, float max_dist, const unsigned int *marks,
+                        unsigned int stamp) {
+  const EnemyGrid *grid = &g->enemy_grid;
+  if (grid->count == 0) return -1;
+  int cx = grid_col(x);
+  int cy = grid_row(y);
+  int best = -1;
+  float best_d2 = max_dist * max_dist;
+  int max_ring = (int)(max_dist / (float)ENEMY_GRID_CELL) + 1;
+  for (int ring = 0; ring <= max_ring; ring++) {
+    float ring_min = (float)(ring - 1) * (float)ENEMY_GRID_CELL;
+    if (ring > 0 && best >= 0 && ring_min * ring_min > best_d2) break;
+    for (int r = cy - ring; r <= cy + ring; r++) {
+      if (r < 0 || r >= ENEMY_GRID_ROWS) continue;
+      int edge_row = r == cy - ring || r == cy + ring;
+      for (int c = cx - ring; c <= cx + ring; c += edge_row ? 1 : 2 * ring) {
+        if (c < 0 || c >= ENEMY_GRID_COLS) continue;
+        int cell = r * ENEMY_GRID_COLS + c;
+        for (int k = grid->cell_start[cell]; k < grid->cell_start[cell + 1]; k++) {
+          int idx = grid->items[k];
+          const Enemy *en = &g->enemies[idx];
+          if (!en->active) continue;
+          if (marks && marks[idx] == stamp) continue;
+          float dx = en->x - x;
+          float dy = en->y - y;
+          float d2 = dx * dx + dy * dy;
+          if (d2 < best_d2 || (d2 == best_d2 && best >= 0 && idx < best)) {
+            best_d2 = d2;
+            best = idx;
+          }
+        }
+      }
+    }
+  }
+  return best;
+}
+
+int enemy_grid_nearest(const Game *g, float x, float y, float max_dist) {
+  return grid_nearest(g, x, y, max_dist, NULL, 0);
+}
+
+int enemy_grid_nearest_unmarked(const Game *g, float x, float y, float max_dist, const unsigned int *marks,
+                                unsigned int stamp) {
+  return grid_nearest(g, x, y, max_dist, marks, stamp);
+}
@@ -0,0 +1,44 @@
+#include "systems/targeting.h"
+
+#include "systems/debuffs.h"
+
+/* One pass over the enemies feeds every weapon this tick: the nearest
+   target, a short nearest-first list and the on-screen candidates. */
+void targeting_update(Game *g) {
+  Targeting *t = &g->targeting;
+  const Player *p = &g->player;
+  float cam_min_x = g->camera_x;
+  float cam_max_x = g->camera_x + g->view_w;
+  float cam_min_y = g->camera_y;
+  float cam_max_y = g->camera_y + g->view_h;
+  t->knn_count = 0;
+  t->onscreen_count = 0;
+  for (int e = 0; e < g->caps.enemies; e++) {
+    const Enemy *en = &g->enemies[e];
+    if (!en->active) continue;
+    if (debuff_active(g, en, DEBUFF_SPAWN_INVULN)) continue;
+    if (en->x >= cam_min_x && en->x <= cam_max_x && en->y >= cam_min_y && en->y <= cam_max_y) {
+      t->onscreen[t->onscreen_count++] = e;
+    }
+    float dx = en->x - p->x;
+    float dy = en->y - p->y;
+    float d2 = dx * dx + dy * dy;
+    if (t->knn_count == TARGET_KNN && d2 >= t->knn_d2[TARGET_KNN - 1]) continue;
+    int pos = t->knn_count < TARGET_KNN ? t->knn_count++ : TARGET_KNN - 1;
+    while (pos > 0 && t->knn_d2[pos - 1] > d2) {
+      t->knn[pos] = t->knn[pos - 1];
+      t->knn_d2[pos] = t->knn_d2[pos - 1];
+      pos--;
+    }
+    t->knn[pos] = e;
+    t->knn_d2[pos] = d2;
+  }
+  t->nearest = t->knn_count > 0 ? t->knn[0] : -1;
+  t->nearest_d2 = t->knn_count > 0 ? t->knn_d2[0] : 0.0f;
+}
+
+int targeting_random_onscreen(const Game *g) {
+  const Targeting *t = &g->targeting;
+  if (t->onscreen_count <= 0) return -1;
+  return t->onscreen[rand() % t->onscreen_count];
+}
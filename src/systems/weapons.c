@@ -1,33 +1,56 @@
 #include "systems/weapons.h"
+#include "systems/debuffs.h"
 #include "systems/enemies.h"
+#include "systems/field.h"
+#include "systems/hits.h"
+#include "systems/projectiles.h"
+#include "systems/queries.h"
+#include "systems/spatial.h"
+#include "systems/targeting.h"
 
-void spawn_bullet(Game *g, float x, float y, float vx, float vy, float damage, int pierce, int homing, int from_player,
+#include <assert.h>
+
+void spawn_bullet(Game *g, float x, float y, float vx, float vy, float damage, int pierce, int homing,
                   int weapon_index, float bleed_chance, float burn_chance, float slow_chance, float stun_chance,
                   float armor_shred_chance) {
-  for (int i = 0; i < MAX_BULLETS; i++) {
-    if (!g->bullets[i].active) {
-      Bullet *b = &g->bullets[i];
-      memset(b, 0, sizeof(*b));
-      b->active = 1;
-      b->x = x;
-      b->y = y;
-      b->vx = vx;
-      b->vy = vy;
-      b->damage = damage;
-      b->pierce = pierce;
-      b->radius = 6.0f;
-      b->lifetime = 2.2f;
-      b->homing = homing;
-      b->from_player = from_player;
-      b->weapon_index = weapon_index;
-      b->bleed_chance = bleed_chance;
-      b->burn_chance = burn_chance;
-      b->slow_chance = slow_chance;
-      b->stun_chance = stun_chance;
-      b->armor_shred_chance = armor_shred_chance;
-      return;
-    }
-  }
+  int i = bullet_ring_alloc(g);
+  if (i < 0) return;
+  BulletRing *r = &g->bullet_ring;
+  Bullet *b = &g->bullets[i];
+  hit_set_clear(g, &b->hits);
+  memset(b, 0, sizeof(*b));
+  b->active = 1;
+  r->x[i] = x;
+  r->y[i] = y;
+  r->px[i] = x;
+  r->py[i] = y;
+  r->vx[i] = vx;
+  r->vy[i] = vy;
+  r->life[i] = BULLET_LIFETIME;
+  r->flags[i] = 0;
+  b->damage = damage;
+  b->pierce = pierce;
+  b->radius = 6.0f;
+  b->homing = homing;
+  b->home_target = -1;
+  b->weapon_index = weapon_index;
+  b->bleed_chance = bleed_chance;
+  b->burn_chance = burn_chance;
+  b->slow_chance = slow_chance;
+  b->stun_chance = stun_chance;
+  b->armor_shred_chance = armor_shred_chance;
+}
+
+/* Enemy and boss shots live packed at the front of enemy_bullets[]. */
+void spawn_enemy_bullet(Game *g, float x, float y, float vx, float vy, float damage) {
+  if (g->enemy_bullet_count >= g->caps.enemy_bullets) return;
+  EnemyBullet *b = &g->enemy_bullets[g->enemy_bullet_count++];
+  b->x = x;
+  b->y = y;
+  b->vx = vx;
+  b->vy = vy;
+  b->damage = damage;
+  b->lifetime = BULLET_LIFETIME;
 }
 
 void spawn_puddle(Game *g, float x, float y, float radius, float dps, float ttl, int kind) {
@@ -52,6 +75,7 @@ void spawn_weapon_fx(Game *g, int type, float x, float y, float angle, float dur
   for (int i = 0; i < MAX_WEAPON_FX; i++) {
     if (!g->weapon_fx[i].active) {
       WeaponFX *fx = &g->weapon_fx[i];
+      hit_set_clear(g, &fx->hits);
       memset(fx, 0, sizeof(*fx));
       fx->active = 1;
       fx->type = type;
@@ -70,6 +94,7 @@ void spawn_scythe_fx(Game *g, float cx, float cy, float angle, float radial_spee
   for (int i = 0; i < MAX_WEAPON_FX; i++) {
     if (!g->weapon_fx[i].active) {
       WeaponFX *fx = &g->weapon_fx[i];
+      hit_set_clear(g, &fx->hits);
       memset(fx, 0, sizeof(*fx));
       fx->active = 1;
       fx->type = 0;
@@ -82,7 +107,6 @@ void spawn_scythe_fx(Game *g, float cx, float cy, float angle, float radial_spee
       fx->radial_speed = radial_speed;
       fx->angle_speed = angle_speed;
       fx->damage = damage;
-      fx->scythe_id = ++g->scythe_id_counter;
       fx->scythe_hit_boss = 0;
       fx->start_angle = angle;
       return;
@@ -92,6 +116,9 @@ void spawn_scythe_fx(Game *g, float cx, float cy, float angle, float radial_spee
 
 void update_weapon_fx(Game *g, float dt) {
   Stats stats = player_total_stats(&g->player, &g->db);
+  int *cand = SCRATCH_NEW(&g->tick_scratch, int, g->caps.enemies);
+  /* The tick block reserves TICK_SCRATCH_ENEMY_LISTS of these lists. */
+  assert(cand);
   for (int i = 0; i < MAX_WEAPON_FX; i++) {
     if (!g->weapon_fx[i].active) continue;
     WeaponFX *fx = &g->weapon_fx[i];
@@ -106,24 +133,20 @@ void update_weapon_fx(Game *g, float dt) {
         continue;
       }
       float hit_r = 34.0f;
-      float hit_r2 = hit_r * hit_r;
-      for (int e = 0; e < MAX_ENEMIES; e++) {
+      int n = enemy_query_ring(g, px, py, 0.0f, hit_r, cand, g->caps.enemies);
+      for (int c = 0; c < n; c++) {
+        int e = cand[c];
         Enemy *en = &g->enemies[e];
-        if (!en->active) continue;
-        if (en->spawn_invuln > 0.0f) continue;
-        if (en->scythe_hit_id == fx->scythe_id) continue;
-        float dx = en->x - px;
-        float dy = en->y - py;
-        if (dx * dx + dy * dy <= hit_r2) {
-          mark_enemy_hit(en);
-          float final_dmg = player_apply_hit_mods(g, en, fx->damage);
-          en->hp -= final_dmg;
-          en->scythe_hit_id = fx->scythe_id;
-          player_try_item_proc(g, e, &stats);
-          if (en->hp <= 0.0f) {
-            if (g->player.alch_ult_phase == 0) {
-              g->player.hp = clampf(g->player.hp + 6.0f, 0.0f, stats.max_hp);
-            }
+        if (debuff_active(g, en, DEBUFF_SPAWN_INVULN)) continue;
+        if (hit_set_contains(g, &fx->hits, e)) continue;
+        mark_enemy_hit(en);
+        float final_dmg = player_apply_hit_mods(g, en, fx->damage);
+        en->hp -= final_dmg;
+        hit_set_add(g, &fx->hits, e);
+        player_try_item_proc(g, e, &stats);
+        if (en->hp <= 0.0f) {
+          if (g->player.alch_ult_phase == 0) {
+            g->player.hp = clampf(g->player.hp + 6.0f, 0.0f, stats.max_hp);
           }
         }
       }
@@ -144,6 +167,8 @@ void update_weapon_fx(Game *g, float dt) {
   }
 }
 
+/* Puddle damage goes through the area-effect field: one cell lookup per
+   enemy instead of a distance test per puddle. */
 void update_puddles(Game *g, float dt) {
   for (int i = 0; i < MAX_PUDDLES; i++) {
     Puddle *p = &g->puddles[i];
@@ -154,146 +179,174 @@ void update_puddles(Game *g, float dt) {
       p->active = 0;
       continue;
     }
-
-    float radius2 = p->radius * p->radius;
-    for (int e = 0; e < MAX_ENEMIES; e++) {
-      if (!g->enemies[e].active) continue;
-      Enemy *en = &g->enemies[e];
-      if (en->spawn_invuln > 0.0f) continue;
-      float dx = en->x - p->x;
-      float dy = en->y - p->y;
-      float d2 = dx * dx + dy * dy;
-      if (d2 <= radius2) {
-        if (p->kind == 2 && en->debuffs.molten_tick_cd > 0.0f) continue;
-        mark_enemy_hit(en);
-        en->hp -= p->dps * dt;
-        if (p->kind == 2) en->debuffs.molten_tick_cd = 0.25f;
-        if (p->log_timer <= 0.0f) {
-          log_combatf(g, "puddle tick %s for %.1f", enemy_label(g, en), p->dps * dt);
-        }
-      }
-    }
     if (p->dps > 0.0f) {
       totem_damage_at(g, p->x, p->y, p->radius, p->dps * dt);
     }
-    if (p->log_timer <= 0.0f) p->log_timer = 0.25f;
+  }
+  if (damage_field_build(g)) damage_field_apply(g, dt);
+  for (int i = 0; i < MAX_PUDDLES; i++) {
+    Puddle *p = &g->puddles[i];
+    if (p->active && p->log_timer <= 0.0f) p->log_timer = 0.25f;
   }
 }
 
+static void bullet_hit_enemy(Game *g, Bullet *b, int e, Stats *stats, float item_burn) {
+  Enemy *en = &g->enemies[e];
+  mark_enemy_hit(en);
+  float dmg = player_apply_hit_mods(g, en, b->damage);
+  en->hp -= dmg;
+  if (b->weapon_index >= 0 && b->weapon_index < g->db.weapon_count) {
+    WeaponDef *w = &g->db.weapons[b->weapon_index];
+    log_combatf(g, "hit %s with %s for %.1f", enemy_label(g, en), w->name, dmg);
+  } else {
+    log_combatf(g, "hit %s for %.1f", enemy_label(g, en), dmg);
+  }
+  if (b->bleed_chance > 0.0f && frandf() < b->bleed_chance) {
+    debuff_add_bleed(g, en, 4.0f);
+    log_combatf(g, "bleed applied to %s", enemy_label(g, en));
+  }
+  if (b->burn_chance > 0.0f && frandf() < b->burn_chance) {
+    debuff_apply(g, en, DEBUFF_BURN, 4.0f);
+    log_combatf(g, "burn applied to %s", enemy_label(g, en));
+  }
+  if (item_burn > 0.0f && debuff_active(g, en, DEBUFF_BURN)) {
+    log_combatf(g, "burn_on_hit applied to %s", enemy_label(g, en));
+  }
+  if (b->slow_chance > 0.0f && frandf() < b->slow_chance) {
+    debuff_apply(g, en, DEBUFF_SLOW, 2.5f);
+    log_combatf(g, "slow applied to %s", enemy_label(g, en));
+  }
+  if (b->stun_chance > 0.0f && frandf() < b->stun_chance) {
+    debuff_apply(g, en, DEBUFF_STUN, 0.6f);
+    log_combatf(g, "stun applied to %s", enemy_label(g, en));
+  }
+  if (b->armor_shred_chance > 0.0f && frandf() < b->armor_shred_chance) {
+    debuff_apply(g, en, DEBUFF_ARMOR_SHRED, 3.0f);
+    log_combatf(g, "armor_shred applied to %s", enemy_label(g, en));
+  }
+  player_try_item_proc(g, e, stats);
+}
+
+/* Homing shots keep their target between retargets instead of searching
+   every tick; a dead or replaced target forces an early retarget. */
+static void steer_homing_bullet(Game *g, int i, float dt) {
+  BulletRing *r = &g->bullet_ring;
+  Bullet *b = &g->bullets[i];
+  b->retarget_timer -= dt;
+  int t = b->home_target;
+  if (t >= 0 && (!g->enemies[t].active || g->enemies[t].gen != b->home_gen)) t = -1;
+  if (t < 0 || b->retarget_timer <= 0.0f) {
+    t = enemy_grid_nearest(g, r->x[i], r->y[i], HOMING_RANGE);
+    b->home_target = t;
+    b->home_gen = t >= 0 ? g->enemies[t].gen : 0;
+    b->retarget_timer = HOMING_RETARGET_INTERVAL;
+  }
+  if (t >= 0) {
+    float tx = g->enemies[t].x - r->x[i];
+    float ty = g->enemies[t].y - r->y[i];
+    vec_norm(&tx, &ty);
+    r->vx[i] = 0.85f * r->vx[i] + 0.15f * tx * 350.0f;
+    r->vy[i] = 0.85f * r->vy[i] + 0.15f * ty * 350.0f;
+  }
+}
+
+/* Collisions are swept from the pre-step position so fast shots and
+   large time scales can't step over a target. */
+static void collide_player_bullet(Game *g, int i, Stats *stats, float item_burn) {
+  BulletRing *r = &g->bullet_ring;
+  Bullet *b = &g->bullets[i];
+  SweepHit hits[MAX_SWEEP_HITS];
+  if (r->flags[i] & BULLET_EXPIRED) { b->active = 0; return; }
+
+  float x0 = r->px[i];
+  float y0 = r->py[i];
+  float x1 = r->x[i];
+  float y1 = r->y[i];
+  if (totem_damage_at(g, x1, y1, b->radius + 6.0f, b->damage)) {
+    b->active = 0;
+    return;
+  }
+  if (g->mode == MODE_BOSS_EVENT && g->boss.active && !b->hit_boss) {
+    const BossDef *bdef = &g_boss_defs[g->boss.def_index];
+    float t;
+    if (segment_circle_hit(x0, y0, x1, y1, g->boss.x, g->boss.y, bdef->radius, &t)) {
+      g->boss.hp -= b->damage;
+      b->hit_boss = 1;
+      b->pierce -= 1;
+      if (b->pierce < 0) { b->active = 0; }
+      return;
+    }
+  }
+  int n = enemy_grid_sweep(g, x0, y0, x1, y1, b->radius, hits, MAX_SWEEP_HITS);
+  for (int h = 0; h < n; h++) {
+    Enemy *en = &g->enemies[hits[h].enemy];
+    if (!en->active) continue;
+    /* A piercing shot overlaps its victim for several ticks; only the first counts. */
+    if (hit_set_contains(g, &b->hits, hits[h].enemy)) continue;
+    if (debuff_active(g, en, DEBUFF_SPAWN_INVULN)) {
+      b->active = 0;
+      return;
+    }
+    hit_set_add(g, &b->hits, hits[h].enemy);
+    bullet_hit_enemy(g, b, hits[h].enemy, stats, item_burn);
+    b->pierce -= 1;
+    if (b->pierce < 0) {
+      b->active = 0;
+      return;
+    }
+  }
+
+  if (r->flags[i] & BULLET_OUTSIDE) b->active = 0;
+}
+
 void update_bullets(Game *g, float dt) {
   Player *p = &g->player;
+  BulletRing *r = &g->bullet_ring;
   Stats stats = player_total_stats(p, &g->db);
   float item_burn = player_burn_on_hit(p, &g->db);
-  for (int i = 0; i < MAX_BULLETS; i++) {
-    Bullet *b = &g->bullets[i];
-    if (!b->active) continue;
+  enemy_grid_build(g);
+  for (unsigned int k = r->head; k != r->tail; k++) {
+    int i = (int)(k & g->bullet_ring.mask);
+    if (g->bullets[i].active && g->bullets[i].homing) steer_homing_bullet(g, i, dt);
+  }
+  bullet_ring_integrate(r, dt);
+  for (unsigned int k = r->head; k != r->tail; k++) {
+    int i = (int)(k & g->bullet_ring.mask);
+    if (g->bullets[i].active) collide_player_bullet(g, i, &stats, item_burn);
+  }
+  bullet_ring_retire(g);
+}
+
+void update_enemy_bullets(Game *g, float dt) {
+  Player *p = &g->player;
+  float armor = player_total_stats(p, &g->db).armor;
+  int i = 0;
+  while (i < g->enemy_bullet_count) {
+    EnemyBullet *b = &g->enemy_bullets[i];
+    int alive = 1;
     b->lifetime -= dt;
-    if (b->lifetime <= 0.0f) { b->active = 0; continue; }
-
-    if (b->homing && b->from_player) {
-      float best = 999999.0f;
-      int best_i = -1;
-      for (int e = 0; e < MAX_ENEMIES; e++) {
-        if (!g->enemies[e].active) continue;
-        float dx = g->enemies[e].x - b->x;
-        float dy = g->enemies[e].y - b->y;
-        float d2 = dx*dx + dy*dy;
-        if (d2 < best) { best = d2; best_i = e; }
-      }
-      if (best_i >= 0) {
-        float tx = g->enemies[best_i].x - b->x;
-        float ty = g->enemies[best_i].y - b->y;
-        vec_norm(&tx, &ty);
-        b->vx = 0.85f * b->vx + 0.15f * tx * 350.0f;
-        b->vy = 0.85f * b->vy + 0.15f * ty * 350.0f;
+    if (b->lifetime <= 0.0f) {
+      alive = 0;
+    } else {
+      float x0 = b->x;
+      float y0 = b->y;
+      float t;
+      b->x += b->vx * dt;
+      b->y += b->vy * dt;
+      if (segment_circle_hit(x0, y0, b->x, b->y, p->x, p->y, 20.0f, &t)) {
+        float dmg = damage_after_armor(b->damage, armor);
+        if (p->alch_ult_phase == 0) p->hp -= player_damage_reduce(g, dmg);
+        alive = 0;
+      } else if (b->x < 0 || b->x > ARENA_W || b->y < 0 || b->y > ARENA_H) {
+        alive = 0;
       }
     }
-
-    b->x += b->vx * dt;
-    b->y += b->vy * dt;
-
-    if (b->x < 0 || b->x > ARENA_W || b->y < 0 || b->y > ARENA_H) {
-      b->active = 0;
-      continue;
-    }
-
-    if (b->from_player) {
-      if (totem_damage_at(g, b->x, b->y, b->radius + 6.0f, b->damage)) {
-        b->active = 0;
-        continue;
-      }
-      if (g->mode == MODE_BOSS_EVENT && g->boss.active) {
-        const BossDef *bdef = &g_boss_defs[g->boss.def_index];
-        float dx = g->boss.x - b->x;
-        float dy = g->boss.y - b->y;
-        float r = bdef->radius;
-        if (dx * dx + dy * dy < r * r) {
-          g->boss.hp -= b->damage;
-          b->pierce -= 1;
-          if (b->pierce < 0) { b->active = 0; }
-          continue;
-        }
-      }
-      for (int e = 0; e < MAX_ENEMIES; e++) {
-        Enemy *en = &g->enemies[e];
-        if (!en->active) continue;
-        float dx = en->x - b->x;
-        float dy = en->y - b->y;
-        float radius = 16.0f;
-        if (dx * dx + dy * dy < (radius + b->radius) * (radius + b->radius)) {
-          if (en->spawn_invuln > 0.0f) {
-            b->active = 0;
-            break;
-          }
-          mark_enemy_hit(en);
-          float dmg = player_apply_hit_mods(g, en, b->damage);
-          en->hp -= dmg;
-          if (b->weapon_index >= 0 && b->weapon_index < g->db.weapon_count) {
-            WeaponDef *w = &g->db.weapons[b->weapon_index];
-            log_combatf(g, "hit %s with %s for %.1f", enemy_label(g, en), w->name, dmg);
-          } else {
-            log_combatf(g, "hit %s for %.1f", enemy_label(g, en), dmg);
-          }
-          if (b->bleed_chance > 0.0f && frandf() < b->bleed_chance) {
-            en->debuffs.bleed_stacks = (en->debuffs.bleed_stacks < 5) ? en->debuffs.bleed_stacks + 1 : 5;
-            en->debuffs.bleed_timer = 4.0f;
-            log_combatf(g, "bleed applied to %s", enemy_label(g, en));
-          }
-          if (b->burn_chance > 0.0f && frandf() < b->burn_chance) {
-            en->debuffs.burn_timer = 4.0f;
-            log_combatf(g, "burn applied to %s", enemy_label(g, en));
-          }
-          if (item_burn > 0.0f && en->debuffs.burn_timer > 0.0f) {
-            log_combatf(g, "burn_on_hit applied to %s", enemy_label(g, en));
-          }
-          if (b->slow_chance > 0.0f && frandf() < b->slow_chance) {
-            en->debuffs.slow_timer = 2.5f;
-            log_combatf(g, "slow applied to %s", enemy_label(g, en));
-          }
-          if (b->stun_chance > 0.0f && frandf() < b->stun_chance) {
-            en->debuffs.stun_timer = 0.6f;
-            log_combatf(g, "stun applied to %s", enemy_label(g, en));
-          }
-          if (b->armor_shred_chance > 0.0f && frandf() < b->armor_shred_chance) {
-            en->debuffs.armor_shred_timer = 3.0f;
-            log_combatf(g, "armor_shred applied to %s", enemy_label(g, en));
-          }
-          player_try_item_proc(g, e, &stats);
-          b->pierce -= 1;
-          if (b->pierce < 0) { b->active = 0; }
-          break;
-        }
-      }
+    if (alive) {
+      i++;
     } else {
-      float dx = p->x - b->x;
-      float dy = p->y - b->y;
-      if (dx * dx + dy * dy < 400.0f) { 
-        float dmg = damage_after_armor(b->damage, stats.armor); 
-        if (p->alch_ult_phase == 0) p->hp -= player_damage_reduce(g, dmg); 
-        b->active = 0; 
-      } 
-    } 
-  } 
+      *b = g->enemy_bullets[--g->enemy_bullet_count];
+    }
+  }
 }
 
 void update_sword_orbit(Game *g, float dt) {
@@ -318,6 +371,10 @@ void fire_weapons(Game *g, float dt) {
   float attack_speed = 1.0f + stats.attack_speed;
   float cooldown_scale = clampf(1.0f - stats.cooldown_reduction, 0.4f, 1.0f);
   float item_burn = player_burn_on_hit(p, &g->db);
+  int *cand = SCRATCH_NEW(&g->tick_scratch, int, g->caps.enemies);
+  assert(cand);
+  enemy_grid_build(g);
+  targeting_update(g);
 
   for (int i = 0; i < MAX_WEAPON_SLOTS; i++) {
     WeaponSlot *slot = &p->weapons[i];
@@ -370,44 +427,39 @@ void fire_weapons(Game *g, float dt) {
       }
 
       totem_damage_at(g, tip_x, tip_y, 22.0f, damage);
-      for (int e = 0; e < MAX_ENEMIES; e++) {
+      int n = enemy_query_obb(g, mid_x, mid_y, cos_a, sin_a, half_l, half_w, cand, g->caps.enemies);
+      for (int c = 0; c < n; c++) {
+          int e = cand[c];
           Enemy *en = &g->enemies[e];
-          if (!en->active) continue;
-          if (en->spawn_invuln > 0.0f) continue;
-          if (en->sword_hit_cd > 0.0f) continue;
-          float dx = en->x - mid_x;
-          float dy = en->y - mid_y;
-          float local_x = -dx * sin_a + dy * cos_a;
-          float local_y = dx * cos_a + dy * sin_a;
-          if (fabsf(local_x) > half_w || fabsf(local_y) > half_l) continue;
+          if (debuff_active(g, en, DEBUFF_SPAWN_INVULN)) continue;
+          if (debuff_active(g, en, DEBUFF_SWORD_CD)) continue;
           mark_enemy_hit(en);
           float final_dmg = player_roll_crit_damage(&stats, w, damage);
           final_dmg = player_apply_hit_mods(g, en, final_dmg);
           en->hp -= final_dmg;
-          en->sword_hit_cd = SWORD_ORBIT_HIT_COOLDOWN / attack_speed;
+          debuff_apply(g, en, DEBUFF_SWORD_CD, SWORD_ORBIT_HIT_COOLDOWN / attack_speed);
           log_combatf(g, "hit %s with %s for %.1f", enemy_label(g, en), w->name, final_dmg);
           if (chances.bleed > 0.0f && frandf() < chances.bleed) {
-            en->debuffs.bleed_stacks = (en->debuffs.bleed_stacks < 5) ? en->debuffs.bleed_stacks + 1 : 5;
-            en->debuffs.bleed_timer = 4.0f;
+            debuff_add_bleed(g, en, 4.0f);
             log_combatf(g, "bleed applied to %s", enemy_label(g, en));
           }
           if (chances.burn > 0.0f && frandf() < chances.burn) {
-            en->debuffs.burn_timer = 4.0f;
+            debuff_apply(g, en, DEBUFF_BURN, 4.0f);
             log_combatf(g, "burn applied to %s", enemy_label(g, en));
           }
-          if (item_burn > 0.0f && en->debuffs.burn_timer > 0.0f) {
+          if (item_burn > 0.0f && debuff_active(g, en, DEBUFF_BURN)) {
             log_combatf(g, "burn_on_hit applied to %s", enemy_label(g, en));
           }
           if (chances.slow > 0.0f && frandf() < chances.slow) {
-            en->debuffs.slow_timer = 2.5f;
+            debuff_apply(g, en, DEBUFF_SLOW, 2.5f);
             log_combatf(g, "slow applied to %s", enemy_label(g, en));
           }
           if (chances.stun > 0.0f && frandf() < chances.stun) {
-            en->debuffs.stun_timer = 0.6f;
+            debuff_apply(g, en, DEBUFF_STUN, 0.6f);
             log_combatf(g, "stun applied to %s", enemy_label(g, en));
           }
           if (chances.shred > 0.0f && frandf() < chances.shred) {
-            en->debuffs.armor_shred_timer = 3.0f;
+            debuff_apply(g, en, DEBUFF_ARMOR_SHRED, 3.0f);
             log_combatf(g, "armor_shred applied to %s", enemy_label(g, en));
           }
           player_try_item_proc(g, e, &stats);
@@ -433,39 +485,11 @@ void fire_weapons(Game *g, float dt) {
       float dy = target_y - p->y;
       best = dx * dx + dy * dy;
     } else if (weapon_is(w, "alchemist_puddle")) {
-      int onscreen_count = 0;
-      float cam_min_x = g->camera_x;
-      float cam_max_x = g->camera_x + g->view_w;
-      float cam_min_y = g->camera_y;
-      float cam_max_y = g->camera_y + g->view_h;
-      for (int e = 0; e < MAX_ENEMIES; e++) {
-        if (!g->enemies[e].active) continue;
-        if (g->enemies[e].spawn_invuln > 0.0f) continue;
-        float ex = g->enemies[e].x;
-        float ey = g->enemies[e].y;
-        if (ex < cam_min_x || ex > cam_max_x || ey < cam_min_y || ey > cam_max_y) continue;
-        onscreen_count++;
-      }
-      if (onscreen_count <= 0) continue;
-      int pick = rand() % onscreen_count;
-      for (int e = 0; e < MAX_ENEMIES; e++) {
-        if (!g->enemies[e].active) continue;
-        if (g->enemies[e].spawn_invuln > 0.0f) continue;
-        float ex = g->enemies[e].x;
-        float ey = g->enemies[e].y;
-        if (ex < cam_min_x || ex > cam_max_x || ey < cam_min_y || ey > cam_max_y) continue;
-        if (pick-- == 0) { target = e; break; }
-      }
+      target = targeting_random_onscreen(g);
       if (target < 0) continue;
     } else {
-      for (int e = 0; e < MAX_ENEMIES; e++) {
-        if (!g->enemies[e].active) continue;
-        if (g->enemies[e].spawn_invuln > 0.0f) continue;
-        float dx = g->enemies[e].x - p->x;
-        float dy = g->enemies[e].y - p->y;
-        float d2 = dx * dx + dy * dy;
-        if (d2 < best) { best = d2; target = e; }
-      }
+      target = g->targeting.nearest;
+      best = g->targeting.nearest_d2;
       if (target < 0) continue;
     }
 
@@ -502,24 +526,20 @@ void fire_weapons(Game *g, float dt) {
           g->boss.hp -= final_dmg;
         }
       } else {
-        for (int e = 0; e < MAX_ENEMIES; e++) {
-          if (!g->enemies[e].active) continue;
+        int n = enemy_query_ring(g, p->x, p->y, 0.0f, range, cand, g->caps.enemies);
+        for (int c = 0; c < n; c++) {
+          int e = cand[c];
           Enemy *en = &g->enemies[e];
-          if (en->spawn_invuln > 0.0f) continue;
-          float ex = en->x - p->x;
-          float ey = en->y - p->y;
-          float d2 = ex * ex + ey * ey;
-          if (d2 <= range2) {
-            mark_enemy_hit(en);
-            float final_dmg = player_roll_crit_damage(&stats, w, damage);
-            final_dmg = player_apply_hit_mods(g, en, final_dmg);
-            en->hp -= final_dmg;
-            log_combatf(g, "hit %s with %s for %.1f", enemy_label(g, en), w->name, final_dmg);
-            player_try_item_proc(g, e, &stats);
-            if (frandf() < 0.15f) {
-              en->debuffs.stun_timer = 0.3f;
-              log_combatf(g, "stun applied to %s", enemy_label(g, en));
-            }
+          if (debuff_active(g, en, DEBUFF_SPAWN_INVULN)) continue;
+          mark_enemy_hit(en);
+          float final_dmg = player_roll_crit_damage(&stats, w, damage);
+          final_dmg = player_apply_hit_mods(g, en, final_dmg);
+          en->hp -= final_dmg;
+          log_combatf(g, "hit %s with %s for %.1f", enemy_label(g, en), w->name, final_dmg);
+          player_try_item_proc(g, e, &stats);
+          if (frandf() < 0.15f) {
+            debuff_apply(g, en, DEBUFF_STUN, 0.3f);
+            log_combatf(g, "stun applied to %s", enemy_label(g, en));
           }
         }
       }
@@ -546,62 +566,49 @@ void fire_weapons(Game *g, float dt) {
       float line_cx = p->x + tx * (range * 0.5f);
       float line_cy = p->y + ty * (range * 0.5f);
       totem_damage_at(g, line_cx, line_cy, range * 0.5f + half_width, damage);
-      if (g->mode == MODE_BOSS_EVENT && g->boss.active) {
-        float ex = g->boss.x - p->x;
-        float ey = g->boss.y - p->y;
-        float proj = ex * tx + ey * ty;
-        if (proj > 0.0f && proj <= range) {
-          float perp = fabsf(ex * (-ty) + ey * tx);
-          if (perp <= half_width + g_boss_defs[g->boss.def_index].radius) {
-            float final_dmg = player_roll_crit_damage(&stats, w, damage);
-            g->boss.hp -= final_dmg;
-          }
-        }
+      if (g->mode == MODE_BOSS_EVENT && g->boss.active &&
+          geom_in_obb(g->boss.x, g->boss.y, line_cx, line_cy, tx, ty, range * 0.5f,
+                      half_width + g_boss_defs[g->boss.def_index].radius)) {
+        float final_dmg = player_roll_crit_damage(&stats, w, damage);
+        g->boss.hp -= final_dmg;
       }
-      for (int e = 0; e < MAX_ENEMIES; e++) {
-        if (!g->enemies[e].active) continue;
-        float ex = g->enemies[e].x - p->x;
-        float ey = g->enemies[e].y - p->y;
-        float proj = ex * tx + ey * ty;
-        if (proj < 0.0f || proj > range) continue;
-        float perp = fabsf(ex * (-ty) + ey * tx);
-        if (perp <= half_width) {
-          Enemy *en = &g->enemies[e];
-          if (en->spawn_invuln > 0.0f) continue;
-          mark_enemy_hit(en);
-          float final_dmg = player_roll_crit_damage(&stats, w, damage);
-          final_dmg = player_apply_hit_mods(g, en, final_dmg);
-          en->hp -= final_dmg;
-          log_combatf(g, "hit %s with %s for %.1f", enemy_label(g, en), w->name, final_dmg);
-          if (chances.bleed > 0.0f && frandf() < chances.bleed) {
-            en->debuffs.bleed_stacks = (en->debuffs.bleed_stacks < 5) ? en->debuffs.bleed_stacks + 1 : 5;
-            en->debuffs.bleed_timer = 4.0f;
-            log_combatf(g, "bleed applied to %s", enemy_label(g, en));
-          }
-          if (chances.burn > 0.0f && frandf() < chances.burn) {
-            en->debuffs.burn_timer = 4.0f;
-            log_combatf(g, "burn applied to %s", enemy_label(g, en));
-          }
-          if (item_burn > 0.0f && en->debuffs.burn_timer > 0.0f) {
-            log_combatf(g, "burn_on_hit applied to %s", enemy_label(g, en));
-          }
-          if (chances.slow > 0.0f && frandf() < chances.slow) {
-            en->debuffs.slow_timer = 2.5f;
-            log_combatf(g, "slow applied to %s", enemy_label(g, en));
-          }
-          if (chances.stun > 0.0f && frandf() < chances.stun) {
-            en->debuffs.stun_timer = 0.6f;
-            log_combatf(g, "stun applied to %s", enemy_label(g, en));
-          }
-          if (chances.shred > 0.0f && frandf() < chances.shred) {
-            en->debuffs.armor_shred_timer = 3.0f;
-            log_combatf(g, "armor_shred applied to %s", enemy_label(g, en));
-          }
-          player_try_item_proc(g, e, &stats);
-          if (weapon_is(w, "chain_blades")) {
-            en->x -= tx * 20.0f;
-            en->y -= ty * 20.0f;
-          }
+      int n = enemy_query_obb(g, line_cx, line_cy, tx, ty, range * 0.5f, half_width, cand, g->caps.enemies);
+      for (int c = 0; c < n; c++) {
+        int e = cand[c];
+        Enemy *en = &g->enemies[e];
+        if (debuff_active(g, en, DEBUFF_SPAWN_INVULN)) continue;
+        mark_enemy_hit(en);
+        float final_dmg = player_roll_crit_damage(&stats, w, damage);
+        final_dmg = player_apply_hit_mods(g, en, final_dmg);
+        en->hp -= final_dmg;
+        log_combatf(g, "hit %s with %s for %.1f", enemy_label(g, en), w->name, final_dmg);
+        if (chances.bleed > 0.0f && frandf() < chances.bleed) {
+          debuff_add_bleed(g, en, 4.0f);
+          log_combatf(g, "bleed applied to %s", enemy_label(g, en));
+        }
+        if (chances.burn > 0.0f && frandf() < chances.burn) {
+          debuff_apply(g, en, DEBUFF_BURN, 4.0f);
+          log_combatf(g, "burn applied to %s", enemy_label(g, en));
+        }
+        if (item_burn > 0.0f && debuff_active(g, en, DEBUFF_BURN)) {
+          log_combatf(g, "burn_on_hit applied to %s", enemy_label(g, en));
+        }
+        if (chances.slow > 0.0f && frandf() < chances.slow) {
+          debuff_apply(g, en, DEBUFF_SLOW, 2.5f);
+          log_combatf(g, "slow applied to %s", enemy_label(g, en));
+        }
+        if (chances.stun > 0.0f && frandf() < chances.stun) {
+          debuff_apply(g, en, DEBUFF_STUN, 0.6f);
+          log_combatf(g, "stun applied to %s", enemy_label(g, en));
+        }
+        if (chances.shred > 0.0f && frandf() < chances.shred) {
+          debuff_apply(g, en, DEBUFF_ARMOR_SHRED, 3.0f);
+          log_combatf(g, "armor_shred applied to %s", enemy_label(g, en));
+        }
+        player_try_item_proc(g, e, &stats);
+        if (weapon_is(w, "chain_blades")) {
+          en->x -= tx * 20.0f;
+          en->y -= ty * 20.0f;
         }
       }
       float level_cd = clampf(1.0f - 0.05f * (slot->level - 1), 0.7f, 1.0f);
@@ -623,45 +630,40 @@ void fire_weapons(Game *g, float dt) {
 
     if (weapon_is(w, "vampire_bite")) {
       float range = w->range;
-      float range2 = range * range;
       totem_damage_at(g, p->x, p->y, range, damage);
       int hits = 0;
-      for (int e = 0; e < MAX_ENEMIES; e++) {
-        if (!g->enemies[e].active) continue;
+      int n = enemy_query_ring(g, p->x, p->y, 0.0f, range, cand, g->caps.enemies);
+      for (int c = 0; c < n; c++) {
+        int e = cand[c];
         Enemy *en = &g->enemies[e];
-        if (en->spawn_invuln > 0.0f) continue;
-        float ex = en->x - p->x;
-        float ey = en->y - p->y;
-        float d2 = ex * ex + ey * ey;
-        if (d2 <= range2) {
-          mark_enemy_hit(en);
-          float final_dmg = player_roll_crit_damage(&stats, w, damage);
-          final_dmg = player_apply_hit_mods(g, en, final_dmg);
-          en->hp -= final_dmg;
-          log_combatf(g, "hit %s with %s for %.1f", enemy_label(g, en), w->name, final_dmg);
-          spawn_weapon_fx(g, 1, en->x, en->y, 0.0f, 0.6f, e);
-          if (p->alch_ult_phase == 0) {
-            p->hp = clampf(p->hp + final_dmg * 0.15f, 0.0f, stats.max_hp);
-          }
-          if (chances.burn > 0.0f && frandf() < chances.burn) {
-            en->debuffs.burn_timer = 4.0f;
-            log_combatf(g, "burn applied to %s", enemy_label(g, en));
-          }
-          if (chances.slow > 0.0f && frandf() < chances.slow) {
-            en->debuffs.slow_timer = 2.5f;
-            log_combatf(g, "slow applied to %s", enemy_label(g, en));
-          }
-          if (chances.stun > 0.0f && frandf() < chances.stun) {
-            en->debuffs.stun_timer = 0.6f;
-            log_combatf(g, "stun applied to %s", enemy_label(g, en));
-          }
-          if (chances.shred > 0.0f && frandf() < chances.shred) {
-            en->debuffs.armor_shred_timer = 3.0f;
-            log_combatf(g, "armor_shred applied to %s", enemy_label(g, en));
-          }
-          player_try_item_proc(g, e, &stats);
-          hits++;
+        if (debuff_active(g, en, DEBUFF_SPAWN_INVULN)) continue;
+        mark_enemy_hit(en);
+        float final_dmg = player_roll_crit_damage(&stats, w, damage);
+        final_dmg = player_apply_hit_mods(g, en, final_dmg);
+        en->hp -= final_dmg;
+        log_combatf(g, "hit %s with %s for %.1f", enemy_label(g, en), w->name, final_dmg);
+        spawn_weapon_fx(g, 1, en->x, en->y, 0.0f, 0.6f, e);
+        if (p->alch_ult_phase == 0) {
+          p->hp = clampf(p->hp + final_dmg * 0.15f, 0.0f, stats.max_hp);
+        }
+        if (chances.burn > 0.0f && frandf() < chances.burn) {
+          debuff_apply(g, en, DEBUFF_BURN, 4.0f);
+          log_combatf(g, "burn applied to %s", enemy_label(g, en));
+        }
+        if (chances.slow > 0.0f && frandf() < chances.slow) {
+          debuff_apply(g, en, DEBUFF_SLOW, 2.5f);
+          log_combatf(g, "slow applied to %s", enemy_label(g, en));
+        }
+        if (chances.stun > 0.0f && frandf() < chances.stun) {
+          debuff_apply(g, en, DEBUFF_STUN, 0.6f);
+          log_combatf(g, "stun applied to %s", enemy_label(g, en));
         }
+        if (chances.shred > 0.0f && frandf() < chances.shred) {
+          debuff_apply(g, en, DEBUFF_ARMOR_SHRED, 3.0f);
+          log_combatf(g, "armor_shred applied to %s", enemy_label(g, en));
+        }
+        player_try_item_proc(g, e, &stats);
+        hits++;
       }
       float level_cd = clampf(1.0f - 0.05f * (slot->level - 1), 0.7f, 1.0f);
       slot->cd_timer = w->cooldown * cooldown_scale * level_cd;
@@ -672,30 +674,12 @@ void fire_weapons(Game *g, float dt) {
       float range = w->range;
       float range2 = range * range;
       int max_targets = 3 + (slot->level - 1);
-      if (max_targets > 6) max_targets = 6;
-
-      int targets[6] = {-1, -1, -1, -1, -1, -1};
-      float dists[6] = {999999.0f, 999999.0f, 999999.0f, 999999.0f, 999999.0f, 999999.0f};
+      if (max_targets > TARGET_KNN) max_targets = TARGET_KNN;
 
-      for (int e = 0; e < MAX_ENEMIES; e++) {
-        if (!g->enemies[e].active) continue;
-        if (g->enemies[e].spawn_invuln > 0.0f) continue;
-        float ex = g->enemies[e].x - p->x;
-        float ey = g->enemies[e].y - p->y;
-        float d2 = ex * ex + ey * ey;
-        if (d2 > range2) continue;
-
-        for (int t = 0; t < max_targets; t++) {
-          if (d2 < dists[t]) {
-            for (int s = max_targets - 1; s > t; s--) {
-              targets[s] = targets[s-1];
-              dists[s] = dists[s-1];
-            }
-            targets[t] = e;
-            dists[t] = d2;
-            break;
-          }
-        }
+      int targets[TARGET_KNN];
+      const Targeting *tg = &g->targeting;
+      for (int t = 0; t < max_targets; t++) {
+        targets[t] = t < tg->knn_count && tg->knn_d2[t] <= range2 ? tg->knn[t] : -1;
       }
 
       float speed = w->projectile_speed > 0 ? w->projectile_speed : 400.0f;
@@ -715,24 +699,23 @@ void fire_weapons(Game *g, float dt) {
         en->hp -= final_dmg;
         log_combatf(g, "hit %s with %s for %.1f", enemy_label(g, en), w->name, final_dmg);
         if (chances.bleed > 0.0f && frandf() < chances.bleed) {
-          en->debuffs.bleed_stacks = (en->debuffs.bleed_stacks < 5) ? en->debuffs.bleed_stacks + 1 : 5;
-          en->debuffs.bleed_timer = 4.0f;
+          debuff_add_bleed(g, en, 4.0f);
           log_combatf(g, "bleed applied to %s", enemy_label(g, en));
         }
         if (chances.burn > 0.0f && frandf() < chances.burn) {
-          en->debuffs.burn_timer = 4.0f;
+          debuff_apply(g, en, DEBUFF_BURN, 4.0f);
           log_combatf(g, "burn applied to %s", enemy_label(g, en));
         }
         if (chances.slow > 0.0f && frandf() < chances.slow) {
-          en->debuffs.slow_timer = 2.5f;
+          debuff_apply(g, en, DEBUFF_SLOW, 2.5f);
           log_combatf(g, "slow applied to %s", enemy_label(g, en));
         }
         if (chances.stun > 0.0f && frandf() < chances.stun) {
-          en->debuffs.stun_timer = 0.6f;
+          debuff_apply(g, en, DEBUFF_STUN, 0.6f);
           log_combatf(g, "stun applied to %s", enemy_label(g, en));
         }
         if (chances.shred > 0.0f && frandf() < chances.shred) {
-          en->debuffs.armor_shred_timer = 3.0f;
+          debuff_apply(g, en, DEBUFF_ARMOR_SHRED, 3.0f);
           log_combatf(g, "armor_shred applied to %s", enemy_label(g, en));
         }
         player_try_item_proc(g, targets[t], &stats);
@@ -750,48 +733,37 @@ void fire_weapons(Game *g, float dt) {
       float arc_deg = weapon_is(w, "axe") || weapon_is(w, "greatsword") || weapon_is(w, "hammer") ? 110.0f : 80.0f;
       float arc_cos = cosf(arc_deg * (3.14159f / 180.0f));
       totem_damage_at(g, p->x, p->y, range, damage);
-      for (int e = 0; e < MAX_ENEMIES; e++) {
-        if (!g->enemies[e].active) continue;
-        float ex = g->enemies[e].x - p->x;
-        float ey = g->enemies[e].y - p->y;
-        float d2 = ex * ex + ey * ey;
-        if (d2 > range * range) continue;
-        float len = sqrtf(d2);
-        if (len < 0.001f) len = 0.001f;
-        float nx = ex / len;
-        float ny = ey / len;
-        float dot = nx * tx + ny * ty;
-        if (dot >= arc_cos) {
-          Enemy *en = &g->enemies[e];
-          if (en->spawn_invuln > 0.0f) continue;
-          mark_enemy_hit(en);
-          float final_dmg = player_roll_crit_damage(&stats, w, damage);
-          final_dmg = player_apply_hit_mods(g, en, final_dmg);
-          en->hp -= final_dmg;
-          log_combatf(g, "hit %s with %s for %.1f", enemy_label(g, en), w->name, final_dmg);
-          if (chances.bleed > 0.0f && frandf() < chances.bleed) {
-            en->debuffs.bleed_stacks = (en->debuffs.bleed_stacks < 5) ? en->debuffs.bleed_stacks + 1 : 5;
-            en->debuffs.bleed_timer = 4.0f;
-            log_combatf(g, "bleed applied to %s", enemy_label(g, en));
-          }
-          if (chances.burn > 0.0f && frandf() < chances.burn) {
-            en->debuffs.burn_timer = 4.0f;
-            log_combatf(g, "burn applied to %s", enemy_label(g, en));
-          }
-          if (chances.slow > 0.0f && frandf() < chances.slow) {
-            en->debuffs.slow_timer = 2.5f;
-            log_combatf(g, "slow applied to %s", enemy_label(g, en));
-          }
-          if (chances.stun > 0.0f && frandf() < chances.stun) {
-            en->debuffs.stun_timer = 0.6f;
-            log_combatf(g, "stun applied to %s", enemy_label(g, en));
-          }
-          if (chances.shred > 0.0f && frandf() < chances.shred) {
-            en->debuffs.armor_shred_timer = 3.0f;
-            log_combatf(g, "armor_shred applied to %s", enemy_label(g, en));
-          }
-          player_try_item_proc(g, e, &stats);
+      int n = enemy_query_sector(g, p->x, p->y, tx, ty, range, arc_cos, cand, g->caps.enemies);
+      for (int c = 0; c < n; c++) {
+        int e = cand[c];
+        Enemy *en = &g->enemies[e];
+        if (debuff_active(g, en, DEBUFF_SPAWN_INVULN)) continue;
+        mark_enemy_hit(en);
+        float final_dmg = player_roll_crit_damage(&stats, w, damage);
+        final_dmg = player_apply_hit_mods(g, en, final_dmg);
+        en->hp -= final_dmg;
+        log_combatf(g, "hit %s with %s for %.1f", enemy_label(g, en), w->name, final_dmg);
+        if (chances.bleed > 0.0f && frandf() < chances.bleed) {
+          debuff_add_bleed(g, en, 4.0f);
+          log_combatf(g, "bleed applied to %s", enemy_label(g, en));
+        }
+        if (chances.burn > 0.0f && frandf() < chances.burn) {
+          debuff_apply(g, en, DEBUFF_BURN, 4.0f);
+          log_combatf(g, "burn applied to %s", enemy_label(g, en));
+        }
+        if (chances.slow > 0.0f && frandf() < chances.slow) {
+          debuff_apply(g, en, DEBUFF_SLOW, 2.5f);
+          log_combatf(g, "slow applied to %s", enemy_label(g, en));
+        }
+        if (chances.stun > 0.0f && frandf() < chances.stun) {
+          debuff_apply(g, en, DEBUFF_STUN, 0.6f);
+          log_combatf(g, "stun applied to %s", enemy_label(g, en));
+        }
+        if (chances.shred > 0.0f && frandf() < chances.shred) {
+          debuff_apply(g, en, DEBUFF_ARMOR_SHRED, 3.0f);
+          log_combatf(g, "armor_shred applied to %s", enemy_label(g, en));
         }
+        player_try_item_proc(g, e, &stats);
       }
       float level_cd = clampf(1.0f - 0.05f * (slot->level - 1), 0.7f, 1.0f);
       slot->cd_timer = w->cooldown * cooldown_scale * level_cd;
@@ -815,7 +787,7 @@ void fire_weapons(Game *g, float dt) {
         float vy = sinf(angle) * w->projectile_speed;
 
         float final_dmg = player_roll_crit_damage(&stats, w, damage);
-        spawn_bullet(g, p->x, p->y, vx, vy, final_dmg, w->pierce, w->homing, 1, slot->def_index,
+        spawn_bullet(g, p->x, p->y, vx, vy, final_dmg, w->pierce, w->homing, slot->def_index,
                      chances.bleed, chances.burn, chances.slow, chances.stun, chances.shred);
       }
       float level_cd = clampf(1.0f - 0.05f * (slot->level - 1), 0.7f, 1.0f);
@@ -1,9 +1,34 @@
 #define UNIT_TESTS
+#include "core/bench.h"
 #include "core/game.h"
+#include "core/pools.h"
+#include "data/data_pack.h"
+#include "data/hot_reload.h"
 #include "data/registry.h"
+#include "render/interp.h"
+#include "systems/crowd.h"
+#include "systems/debuffs.h"
+#include "systems/director.h"
+#include "systems/drops.h"
+#include "systems/enemies.h"
+#include "systems/field.h"
+#include "systems/hits.h"
+#include "systems/procs.h"
+#include "systems/projectiles.h"
+#include "systems/queries.h"
+#include "systems/spatial.h"
+#include "systems/targeting.h"
 #include "systems/weapons.h"
 #include <assert.h>
 
+/* Zeroed game with the default entity pools, as main sets one up. */
+static void test_game_init(Game *g) {
+  memset(g, 0, sizeof(*g));
+  GameCaps caps;
+  assert(game_caps_profile(POOL_PROFILE_DEFAULT, &caps));
+  assert(game_pools_init(g, &caps));
+}
+
 static void test_db_load() {
   Database db;
   memset(&db, 0, sizeof(db));
@@ -14,6 +39,12 @@ static void test_db_load() {
   for (int i = 0; i < db.enemy_count; i++) {
     assert(db.enemies[i].hp > 0.0f);
   }
+  for (int i = 0; i < db.weapon_count; i++) assert(find_weapon(&db, db.weapons[i].id) == i);
+  for (int i = 0; i < db.item_count; i++) assert(find_item(&db, db.items[i].id) == i);
+  for (int i = 0; i < db.enemy_count; i++) assert(find_enemy(&db, db.enemies[i].id) == i);
+  assert(find_weapon(&db, "no_such_weapon") < 0);
+  assert(db.enemy_eye == find_enemy(&db, "eye"));
+  db_free(&db);
 }
 
 static void test_weapon_upgrade() {
@@ -32,6 +63,8 @@ static void test_weapon_upgrade() {
 static void test_stats_scaling() {
   Database db;
   memset(&db, 0, sizeof(db));
+  ItemDef item;
+  db.items = &item;
   db.item_count = 1;
   ItemDef *it = &db.items[0];
   memset(it, 0, sizeof(*it));
@@ -52,8 +85,11 @@ static void test_stats_scaling() {
 
 static void test_kill_count() {
   Game g;
-  memset(&g, 0, sizeof(g));
+  test_game_init(&g);
   g.player.base.max_hp = 100;
+  EnemyDef def;
+  memset(&def, 0, sizeof(def));
+  g.db.enemies = &def;
   g.db.enemy_count = 1;
   strcpy(g.db.enemies[0].role, "grunt");
   g.db.enemies[0].hp = 10;
@@ -63,6 +99,717 @@ static void test_kill_count() {
   g.enemies[0].max_hp = 10.0f;
   update_enemies(&g, 0.016f);
   assert(g.kills == 1);
+  game_pools_free(&g);
+}
+
+static void test_debuffs_exact_and_expire() {
+  static Game g;
+  test_game_init(&g);
+  debuffs_reset(&g);
+  g.player.base.max_hp = 100;
+  g.player.hp = 100;
+  EnemyDef def;
+  memset(&def, 0, sizeof(def));
+  strcpy(def.role, "grunt");
+  def.hp = 100;
+  g.db.enemies = &def;
+  g.db.enemy_count = 1;
+  float dist[2] = {100.0f, 5000.0f};
+  for (int i = 0; i < 2; i++) {
+    g.enemies[i].active = 1;
+    g.enemies[i].x = dist[i];
+    g.enemies[i].hp = 100.0f;
+    g.enemies[i].max_hp = 100.0f;
+    debuff_apply(&g, &g.enemies[i], DEBUFF_BURN, 1.0f);
+  }
+  debuff_add_bleed(&g, &g.enemies[0], 0.5f);
+  debuff_add_bleed(&g, &g.enemies[0], 0.5f);
+  debuff_apply(&g, &g.enemies[1], DEBUFF_STUN, 90.0f); /* beyond the level-1 horizon */
+  assert(g.debuffs.active_count == 2);
+  for (int t = 0; t < 120; t++) {
+    debuffs_update(&g, 1.0f / 60.0f);
+    update_enemies(&g, 1.0f / 60.0f);
+  }
+  assert(g.enemy_lod_counts[0] == 1 && g.enemy_lod_counts[3] == 1);
+  /* burn 4/s for 1 s, plus bleed 2 stacks * 1.5/s for 0.5 s */
+  assert(fabsf(g.enemies[0].hp - 94.5f) < 0.01f);
+  assert(fabsf(g.enemies[1].hp - 96.0f) < 0.01f);
+  assert(g.enemies[0].debuffs.mask == 0 && g.enemies[0].debuffs.bleed_stacks == 0);
+  assert(g.debuffs.active_count == 1);
+  assert(debuff_active(&g, &g.enemies[1], DEBUFF_STUN));
+  for (int t = 0; t < 89 * 60; t++) debuffs_update(&g, 1.0f / 60.0f);
+  assert(!debuff_active(&g, &g.enemies[1], DEBUFF_STUN));
+  assert(g.debuffs.active_count == 0);
+  game_pools_free(&g);
+}
+
+static void test_swept_bullets() {
+  static Game g;
+  test_game_init(&g);
+  debuffs_reset(&g);
+  EnemyDef def;
+  memset(&def, 0, sizeof(def));
+  strcpy(def.role, "grunt");
+  def.hp = 100;
+  g.db.enemies = &def;
+  g.db.enemy_count = 1;
+  float xs[3] = {260.0f, 200.0f, 320.0f};
+  for (int i = 0; i < 3; i++) {
+    g.enemies[i].active = 1;
+    g.enemies[i].x = xs[i];
+    g.enemies[i].y = 100.0f;
+    g.enemies[i].hp = 100.0f;
+  }
+  /* 300 px per step: a point test at the end position would miss all three */
+  spawn_bullet(&g, 100.0f, 100.0f, 3000.0f, 0.0f, 10.0f, 1, 0, -1, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  update_bullets(&g, 0.1f);
+  assert(g.enemies[1].hp < 100.0f && g.enemies[0].hp < 100.0f);
+  assert(g.enemies[2].hp == 100.0f);
+  assert(!g.bullets[0].active);
+
+  /* grid sweep matches a brute-force scan */
+  srand(7);
+  for (int i = 0; i < 600; i++) {
+    g.enemies[i].active = 1;
+    g.enemies[i].x = frandf() * 1200.0f;
+    g.enemies[i].y = frandf() * 1200.0f;
+  }
+  enemy_grid_build(&g);
+  SweepHit hits[MAX_SWEEP_HITS];
+  for (int q = 0; q < 50; q++) {
+    float x0 = frandf() * 1200.0f, y0 = frandf() * 1200.0f;
+    float x1 = x0 + (frandf() - 0.5f) * 300.0f, y1 = y0 + (frandf() - 0.5f) * 300.0f;
+    int n = enemy_grid_sweep(&g, x0, y0, x1, y1, 6.0f, hits, MAX_SWEEP_HITS);
+    int brute = 0;
+    for (int i = 0; i < g.caps.enemies; i++) {
+      float t;
+      if (g.enemies[i].active && segment_circle_hit(x0, y0, x1, y1, g.enemies[i].x, g.enemies[i].y, 22.0f, &t)) brute++;
+    }
+    assert(n == (brute < MAX_SWEEP_HITS ? brute : MAX_SWEEP_HITS));
+    for (int h = 1; h < n; h++) assert(hits[h - 1].t <= hits[h].t);
+  }
+  game_pools_free(&g);
+}
+
+static void test_hit_dedupe() {
+  static Game g;
+  test_game_init(&g);
+  debuffs_reset(&g);
+  EnemyDef def;
+  memset(&def, 0, sizeof(def));
+  strcpy(def.role, "grunt");
+  def.hp = 100;
+  g.db.enemies = &def;
+  g.db.enemy_count = 1;
+  g.enemies[0].active = 1;
+  g.enemies[0].x = 120.0f;
+  g.enemies[0].y = 100.0f;
+  g.enemies[0].hp = 100.0f;
+  /* slow piercing shot overlaps the enemy for several ticks */
+  spawn_bullet(&g, 100.0f, 100.0f, 60.0f, 0.0f, 10.0f, 5, 0, -1, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  for (int t = 0; t < 30; t++) update_bullets(&g, 1.0f / 60.0f);
+  assert(fabsf(g.enemies[0].hp - 90.0f) < 0.01f);
+  assert(g.bullets[0].pierce == 4);
+
+  /* past the inline entries the set spills into a pooled bitmap */
+  HitSet *s = &g.bullets[0].hits;
+  for (int e = 0; e < 40; e++) assert(hit_set_add(&g, s, e) || e == 0);
+  assert(s->overflow > 0);
+  for (int e = 0; e < 40; e++) assert(hit_set_contains(&g, s, e));
+  assert(!hit_set_contains(&g, s, 40));
+  /* a reused slot is a different enemy */
+  g.enemies[0].active = 0;
+  g.enemies[30].active = 1;
+  spawn_enemy(&g, 0);
+  assert(!hit_set_contains(&g, s, 0));
+  assert(hit_set_contains(&g, s, 30));
+  g.enemies[30].gen++;
+  hit_sets_forget_enemy(&g, 30);
+  assert(!hit_set_contains(&g, s, 30));
+  hit_set_clear(&g, s);
+  assert(s->overflow == 0 && !g.hit_overflow[0].in_use);
+  game_pools_free(&g);
+}
+
+static void test_bullet_pools() {
+  static Game g;
+  test_game_init(&g);
+  g.player.base.max_hp = 100;
+  g.player.hp = 100;
+  g.player.x = 4000.0f;
+  g.player.y = 4000.0f;
+  /* a saturated enemy pool no longer starves player shots */
+  for (int i = 0; i < g.caps.enemy_bullets + 10; i++) spawn_enemy_bullet(&g, 100.0f, 100.0f, 0.0f, 100.0f, 5.0f);
+  assert(g.enemy_bullet_count == g.caps.enemy_bullets);
+  spawn_bullet(&g, 50.0f, 50.0f, -1000.0f, 0.0f, 1.0f, 0, 0, -1, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  spawn_bullet(&g, 50.0f, 50.0f, 0.0f, 0.0f, 1.0f, 0, 0, -1, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  assert(g.bullets[0].active && g.bullets[1].active && bullet_ring_count(&g.bullet_ring) == 2);
+  /* the oldest shot leaves the arena and the head moves past it */
+  update_bullets(&g, 0.1f);
+  assert(!g.bullets[0].active && g.bullet_ring.head == 1);
+  /* fill the ring; expiry retires shots in spawn order */
+  while (bullet_ring_count(&g.bullet_ring) < g.caps.bullets)
+    spawn_bullet(&g, 4000.0f, 4000.0f, 10.0f, 0.0f, 1.0f, 0, 0, -1, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  spawn_bullet(&g, 4000.0f, 4000.0f, 10.0f, 0.0f, 1.0f, 0, 0, -1, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+  assert(bullet_ring_count(&g.bullet_ring) == g.caps.bullets);
+  for (int t = 0; t < 140; t++) update_bullets(&g, 1.0f / 60.0f);
+  assert(bullet_ring_count(&g.bullet_ring) == 0 && g.bullet_ring.tail == (unsigned int)g.caps.bullets + 1u);
+
+  /* vector and scalar lanes agree across the wrap */
+  BulletRing *r = &g.bullet_ring;
+  r->head = g.caps.bullets - 3;
+  r->tail = g.caps.bullets + 6;
+  for (int i = 0; i < g.caps.bullets; i++) {
+    r->x[i] = (float)(i * 16);
+    r->y[i] = 100.0f;
+    r->vx[i] = i % 2 ? -400.0f : 400.0f;
+    r->vy[i] = 0.0f;
+    r->life[i] = i % 3 ? 1.0f : 0.01f;
+  }
+  bullet_ring_integrate(r, 0.05f);
+  for (unsigned int k = r->head; k != r->tail; k++) {
+    int i = (int)(k & g.bullet_ring.mask);
+    assert(r->px[i] == (float)(i * 16));
+    assert(fabsf(r->x[i] - (float)(i * 16) - r->vx[i] * 0.05f) < 0.001f);
+    assert(!!(r->flags[i] & BULLET_EXPIRED) == (i % 3 == 0));
+    assert(!!(r->flags[i] & BULLET_OUTSIDE) == (r->x[i] < 0.0f || r->x[i] > ARENA_W));
+  }
+
+  g.enemy_bullets[3].x = 4000.0f;
+  g.enemy_bullets[3].y = 3990.0f;
+  update_enemy_bullets(&g, 1.0f / 60.0f);
+  assert(g.enemy_bullet_count == g.caps.enemy_bullets - 1);
+  assert(g.player.hp < 100.0f);
+  for (int t = 0; t < 200; t++) update_enemy_bullets(&g, 1.0f / 60.0f);
+  assert(g.enemy_bullet_count == 0);
+  game_pools_free(&g);
+}
+
+static void test_targeting_matches_scan() {
+  static Game g;
+  test_game_init(&g);
+  debuffs_reset(&g);
+  g.player.x = 600.0f;
+  g.player.y = 600.0f;
+  g.view_w = 400;
+  g.view_h = 300;
+  g.camera_x = 400.0f;
+  g.camera_y = 450.0f;
+  srand(11);
+  for (int i = 0; i < 900; i++) {
+    g.enemies[i].active = 1;
+    g.enemies[i].x = frandf() * 3000.0f;
+    g.enemies[i].y = frandf() * 3000.0f;
+  }
+  debuff_apply(&g, &g.enemies[5], DEBUFF_SPAWN_INVULN, 1.0f);
+  g.enemies[5].x = 601.0f;
+  g.enemies[5].y = 600.0f;
+  targeting_update(&g);
+  int onscreen = 0;
+  float prev = -1.0f;
+  for (int i = 0; i < g.targeting.knn_count; i++) {
+    assert(g.targeting.knn[i] != 5 && g.targeting.knn_d2[i] >= prev);
+    prev = g.targeting.knn_d2[i];
+  }
+  for (int e = 0; e < g.caps.enemies; e++) {
+    Enemy *en = &g.enemies[e];
+    if (!en->active || e == 5) continue;
+    float dx = en->x - 600.0f, dy = en->y - 600.0f;
+    assert(dx * dx + dy * dy >= g.targeting.nearest_d2);
+    if (en->x >= 400.0f && en->x <= 800.0f && en->y >= 450.0f && en->y <= 750.0f) onscreen++;
+  }
+  assert(g.targeting.knn_count == TARGET_KNN && g.targeting.onscreen_count == onscreen);
+  int pick = targeting_random_onscreen(&g);
+  assert(pick >= 0 && pick != 5);
+
+  /* grid nearest-to-point agrees with a full scan */
+  enemy_grid_build(&g);
+  for (int q = 0; q < 100; q++) {
+    float x = frandf() * 3000.0f, y = frandf() * 3000.0f;
+    int best = -1;
+    float best_d2 = 400.0f * 400.0f;
+    for (int e = 0; e < g.caps.enemies; e++) {
+      if (!g.enemies[e].active) continue;
+      float dx = g.enemies[e].x - x, dy = g.enemies[e].y - y;
+      if (dx * dx + dy * dy < best_d2) { best_d2 = dx * dx + dy * dy; best = e; }
+    }
+    assert(enemy_grid_nearest(&g, x, y, 400.0f) == best);
+  }
+  game_pools_free(&g);
+}
+
+static int cmp_int(const void *a, const void *b) {
+  return *(const int *)a - *(const int *)b;
+}
+
+/* Each shape query must return exactly the enemies a full scan finds. */
+static void test_shape_queries_match_brute_force() {
+  static Game g;
+  static int got[ENEMY_CAP_LIMIT];
+  static int want[ENEMY_CAP_LIMIT];
+  test_game_init(&g);
+  srand(5);
+  for (int i = 0; i < 1500; i++) {
+    g.enemies[i].active = i % 7 != 0;
+    g.enemies[i].x = frandf() * 2000.0f;
+    g.enemies[i].y = frandf() * 2000.0f;
+  }
+  enemy_grid_build(&g);
+  for (int q = 0; q < 200; q++) {
+    float x = frandf() * 2000.0f, y = frandf() * 2000.0f;
+    float a = frandf() * 6.28318f;
+    float ux = cosf(a), uy = sinf(a);
+    float len = 20.0f + frandf() * 400.0f;
+    float w = 5.0f + frandf() * 60.0f;
+    float cos_half = cosf(frandf() * 3.0f);
+    int kind = q % 4;
+    int n = 0;
+    if (kind == 0) n = enemy_query_sector(&g, x, y, ux, uy, len, cos_half, got, g.caps.enemies);
+    if (kind == 1) n = enemy_query_obb(&g, x, y, ux, uy, len, w, got, g.caps.enemies);
+    if (kind == 2) n = enemy_query_capsule(&g, x, y, x + ux * len, y + uy * len, w, got, g.caps.enemies);
+    if (kind == 3) n = enemy_query_ring(&g, x, y, w, w + len, got, g.caps.enemies);
+    int m = 0;
+    for (int e = 0; e < g.caps.enemies; e++) {
+      Enemy *en = &g.enemies[e];
+      if (!en->active) continue;
+      int in = 0;
+      if (kind == 0) in = geom_in_sector(en->x, en->y, x, y, ux, uy, len, cos_half);
+      if (kind == 1) in = geom_in_obb(en->x, en->y, x, y, ux, uy, len, w);
+      if (kind == 2) in = geom_in_capsule(en->x, en->y, x, y, x + ux * len, y + uy * len, w);
+      if (kind == 3) in = geom_in_ring(en->x, en->y, x, y, w, w + len);
+      if (in) want[m++] = e;
+    }
+    qsort(got, (size_t)n, sizeof(int), cmp_int);
+    assert(n == m);
+    for (int i = 0; i < n; i++) assert(got[i] == want[i]);
+  }
+  /* spot checks of the predicates themselves */
+  assert(geom_in_obb(10.0f, 3.0f, 0.0f, 0.0f, 1.0f, 0.0f, 10.0f, 3.0f));
+  assert(!geom_in_obb(0.0f, 10.5f, 0.0f, 0.0f, 0.0f, 1.0f, 10.0f, 3.0f));
+  assert(!geom_in_sector(-5.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 50.0f, 0.0f));
+  assert(geom_in_capsule(-3.0f, 0.0f, 0.0f, 0.0f, 10.0f, 0.0f, 4.0f));
+  assert(!geom_in_ring(1.0f, 1.0f, 0.0f, 0.0f, 2.0f, 5.0f));
+  game_pools_free(&g);
+}
+
+static void test_chain_procs_batched() {
+  static Game g;
+  test_game_init(&g);
+  EnemyDef def;
+  memset(&def, 0, sizeof(def));
+  g.db.enemies = &def;
+  g.db.enemy_count = 1;
+  float xs[5] = {100.0f, 130.0f, 160.0f, 190.0f, 400.0f};
+  for (int i = 0; i < 5; i++) {
+    g.enemies[i].active = 1;
+    g.enemies[i].x = xs[i];
+    g.enemies[i].y = 100.0f;
+    g.enemies[i].hp = 50.0f;
+  }
+  procs_queue_chain(&g, 0, 10.0f, 3, 50.0f);
+  procs_queue_chain(&g, 4, 10.0f, 3, 50.0f); /* nothing in reach */
+  procs_queue_chain(&g, 3, 10.0f, 2, 50.0f);
+  assert(g.chain_proc_count == 3);
+  procs_flush(&g);
+  assert(g.chain_proc_count == 0);
+  /* first chain: 1, 2, 3; third chain: 2, then 1 (3 is its own start) */
+  assert(g.enemies[0].hp == 50.0f && g.enemies[4].hp == 50.0f);
+  assert(g.enemies[1].hp == 30.0f && g.enemies[2].hp == 30.0f && g.enemies[3].hp == 40.0f);
+  /* a proc whose start slot was reused before the flush is dropped */
+  procs_queue_chain(&g, 1, 10.0f, 3, 50.0f);
+  g.enemies[1].gen++;
+  procs_flush(&g);
+  assert(g.enemies[0].hp == 50.0f && g.enemies[2].hp == 30.0f);
+  /* stamp wrap clears old marks */
+  g.chain_stamp = 0xffffffffu;
+  procs_queue_chain(&g, 0, 1.0f, 1, 50.0f);
+  procs_flush(&g);
+  assert(g.chain_stamp == 1 && g.enemies[1].hp == 29.0f);
+  game_pools_free(&g);
+}
+
+/* Field sampling must match testing every puddle and aura per enemy. */
+static void test_damage_field_matches_scan() {
+  static Game g;
+  test_game_init(&g);
+  debuffs_reset(&g);
+  EnemyDef def;
+  memset(&def, 0, sizeof(def));
+  g.db.enemies = &def;
+  g.db.enemy_count = 1;
+  ItemDef item;
+  memset(&item, 0, sizeof(item));
+  item.slow_aura = 150.0f;
+  g.db.items = &item;
+  g.db.item_count = 1;
+  g.player.passive_items[0] = 0;
+  g.player.passive_count = 1;
+  g.player.x = 500.0f;
+  g.player.y = 500.0f;
+  srand(3);
+  for (int i = 0; i < 20; i++) {
+    spawn_puddle(&g, 200.0f + frandf() * 600.0f, 200.0f + frandf() * 600.0f, 40.0f + frandf() * 200.0f,
+                 10.0f + frandf() * 50.0f, 5.0f, i % 3 == 0 ? 2 : 0);
+  }
+  static float expect[ENEMY_CAP_LIMIT];
+  int slowed[1000];
+  for (int i = 0; i < 1000; i++) {
+    Enemy *en = &g.enemies[i];
+    en->active = 1;
+    en->x = 100.0f + frandf() * 800.0f;
+    en->y = 100.0f + frandf() * 800.0f;
+    en->hp = 1000.0f;
+    float sum = 0.0f, molten = 0.0f;
+    for (int k = 0; k < MAX_PUDDLES; k++) {
+      Puddle *pd = &g.puddles[k];
+      if (!pd->active) continue;
+      float dx = en->x - pd->x, dy = en->y - pd->y;
+      if (dx * dx + dy * dy > pd->radius * pd->radius) continue;
+      if (pd->kind == 2) molten = fmaxf(molten, pd->dps);
+      else sum += pd->dps;
+    }
+    expect[i] = (sum + molten) * 0.1f;
+    float dx = en->x - 500.0f, dy = en->y - 500.0f;
+    slowed[i] = dx * dx + dy * dy <= 150.0f * 150.0f;
+  }
+  update_puddles(&g, 0.1f);
+  for (int i = 0; i < 1000; i++) {
+    assert(fabsf((1000.0f - g.enemies[i].hp) - expect[i]) < 0.01f);
+    assert(debuff_active(&g, &g.enemies[i], DEBUFF_SLOW) == slowed[i]);
+  }
+  /* molten puddles respect the per-enemy cooldown on the next tick */
+  for (int i = 0; i < 1000; i++) g.enemies[i].hp = 1000.0f;
+  update_puddles(&g, 0.1f);
+  for (int i = 0; i < 1000; i++) assert(1000.0f - g.enemies[i].hp <= expect[i] + 0.01f);
+  game_pools_free(&g);
+}
+
+/* XP orbs merge instead of vanishing when the pool is full. */
+static void test_xp_drops_coalesce() {
+  static Game g;
+  test_game_init(&g);
+  drops_clear(&g);
+  spawn_drop(&g, 100.0f, 100.0f, 0, 2.0f);
+  spawn_drop(&g, 110.0f, 100.0f, 0, 1.0f);
+  assert(g.drops[0].value == 3.0f && !g.drops[1].active && g.drop_stats.merges == 1);
+  assert(drop_xp_scale(1.0f) == 1.0f && drop_xp_scale(8.0f) == 2.0f && drop_xp_scale(1000.0f) == DROP_XP_MAX_SCALE);
+
+  /* spread far apart so only a full pool forces merges */
+  float spawned = 3.0f;
+  for (int i = 0; i < g.caps.drops * 3; i++) {
+    spawn_drop(&g, 200.0f + (float)(i % 64) * 100.0f, 200.0f + (float)(i / 64) * 100.0f, 0, 1.0f);
+    spawned += 1.0f;
+  }
+  float total = 0.0f;
+  int active = 0;
+  for (int i = 0; i < g.caps.drops; i++) {
+    if (!g.drops[i].active) continue;
+    active++;
+    total += g.drops[i].value;
+  }
+  assert(active == g.caps.drops);
+  assert(total == spawned);
+  assert(g.drop_stats.overflows == g.caps.drops * 3 - (g.caps.drops - 1));
+  spawn_drop(&g, 50.0f, 50.0f, 1, 10.0f);
+  assert(g.drop_stats.lost == 1);
+
+  /* attracted orbs close in on the player without overshooting */
+  drops_clear(&g);
+  for (int i = 0; i < 7; i++) {
+    g.drops[i].active = 1;
+    g.drops[i].magnetized = 1;
+    g.drops[i].x = 1000.0f + (float)i * 300.0f;
+    g.drops[i].y = 1000.0f;
+    g.drops[i].magnet_speed = DROP_MAGNET_MAX_SPEED;
+  }
+  g.drops[6].x = 1003.0f;
+  g.drops[7].active = 1;
+  g.drops[7].x = 1500.0f;
+  g.drops[7].y = 1000.0f;
+  drops_magnet_step(&g, 1000.0f, 1000.0f, 0.1f);
+  assert(g.drops[0].x == 1000.0f && g.drops[6].x == 1000.0f);
+  for (int i = 1; i < 6; i++) {
+    assert(fabsf(g.drops[i].x - (1000.0f + (float)i * 300.0f - 60.0f)) < 0.05f);
+    assert(g.drops[i].y == 1000.0f);
+  }
+  assert(g.drops[7].x == 1500.0f);
+  game_pools_free(&g);
+}
+
+/* The shipped curve loads, eases between phases and spawns whole batches. */
+static void test_spawn_director() {
+  static Game g;
+  test_game_init(&g);
+  assert(db_load(&g.db));
+  SpawnDirector *d = &g.director;
+  assert(load_spawn_curve(DATA_SPAWN_CURVE_PATH, d->phases, MAX_SPAWN_PHASES, &d->phase_count));
+  assert(d->phase_count >= 2 && d->phases[0].start == 0.0f);
+  for (int i = 0; i < d->phase_count; i++) {
+    for (int k = 0; k < d->phases[i].enemy_count; k++) assert(find_enemy(&g.db, d->phases[i].enemies[k]) >= 0);
+  }
+  float interval = 0.0f;
+  int batch = 0;
+  float mid = 0.5f * (d->phases[0].start + d->phases[1].start);
+  assert(director_sample(d, mid, &interval, &batch) == 0);
+  assert(fabsf(interval - 0.5f * (d->phases[0].interval + d->phases[1].interval)) < 1e-4f);
+  assert(director_sample(d, 100000.0f, &interval, &batch) == d->phase_count - 1);
+  assert(batch == d->phases[d->phase_count - 1].batch);
+
+  g.view_w = VIEW_W;
+  g.view_h = VIEW_H;
+  g.player.x = ARENA_W * 0.5f;
+  g.player.y = ARENA_H * 0.5f;
+  g.camera_x = g.player.x - VIEW_W * 0.5f;
+  g.camera_y = g.player.y - VIEW_H * 0.5f;
+  int ghost = find_enemy(&g.db, "ghost");
+  assert(spawn_enemy_batch(&g, &ghost, 1, SPAWN_RING, 100) == 100);
+  float r = 0.5f * sqrtf((float)(VIEW_W * VIEW_W + VIEW_H * VIEW_H));
+  for (int i = 0; i < 100; i++) {
+    Enemy *e = &g.enemies[i];
+    assert(e->active && e->def_index == ghost);
+    float dx = e->x - g.player.x;
+    float dy = e->y - g.player.y;
+    assert(dx * dx + dy * dy > r * r);
+  }
+  for (int p = SPAWN_EDGE; p <= SPAWN_LINE; p <<= 1) {
+    assert(spawn_enemy_batch(&g, NULL, 0, (SpawnPattern)p, 10) == 10);
+  }
+  assert(d->batches == 5 && d->spawned == 140);
+
+  /* a full pool spawns what fits and counts the rest */
+  for (int i = 0; i < g.caps.enemies - 5; i++) g.enemies[i].active = 1;
+  g.enemy_alloc_cursor = 0;
+  assert(spawn_enemy_batch(&g, NULL, 0, SPAWN_SWARM, 8) == 5);
+  assert(d->starved == 3);
+  for (int i = 0; i < g.caps.enemies; i++) assert(g.enemies[i].active);
+  db_free(&g.db);
+  game_pools_free(&g);
+}
+
+/* Profiles size every pool from one block; odd sizes are normalised. */
+static void test_pool_profiles() {
+  static Game g;
+  memset(&g, 0, sizeof(g));
+  GameCaps caps;
+  assert(!game_caps_profile("no_such_profile", &caps));
+  assert(game_caps_profile("stress", &caps));
+  assert(game_pools_init(&g, &caps));
+  assert(g.caps.enemies == caps.enemies && g.pool_arena.used == g.pool_arena.size);
+  g.enemies[g.caps.enemies - 1].active = 1;
+  g.wave_snapshot.drops[g.caps.drops - 1].active = 1;
+  caps.bullets = 300;
+  caps.enemies = ENEMY_CAP_LIMIT * 2;
+  assert(game_pools_init(&g, &caps));
+  assert(g.caps.bullets == 512 && g.bullet_ring.mask == 511u && g.caps.enemies == ENEMY_CAP_LIMIT);
+  assert(!g.enemies[0].active && ((size_t)g.bullet_ring.x & (ARENA_ALIGN - 1)) == 0);
+  game_pools_free(&g);
+  assert(g.enemies == NULL && g.caps.enemies == 0);
+}
+
+/* Scratch hands out aligned ranges, rewinds to marks, spills to the heap
+   when full and gives everything back on reset. */
+static void test_scratch_reset_and_spill() {
+  static unsigned char block[256];
+  Scratch s;
+  memset(&s, 0, sizeof(s));
+  s.arena.base = block;
+  s.arena.size = sizeof(block);
+  int *a = SCRATCH_NEW(&s, int, 10);
+  size_t mark = scratch_mark(&s);
+  float *b = SCRATCH_NEW(&s, float, 20);
+  assert(a == (int *)block && ((size_t)b & (ARENA_ALIGN - 1)) == 0);
+  assert(s.high_water == (size_t)((unsigned char *)b - block) + 20 * sizeof(float));
+  scratch_release(&s, mark);
+  assert(SCRATCH_NEW(&s, float, 20) == b);
+  /* Past the block: heap memory, counted, released by the next reset. */
+  char *big = SCRATCH_NEW(&s, char, 4096);
+  assert(big && (big < (char *)block || big >= (char *)block + sizeof(block)));
+  big[4095] = 1;
+  assert(s.spill_count == 1 && s.spills_total == 1);
+  size_t peak = s.high_water;
+  scratch_reset(&s);
+  assert(s.arena.used == 0 && s.spill_count == 0 && s.high_water == peak);
+  assert(SCRATCH_NEW(&s, int, 10) == a);
+
+  /* Pools carve both scratch blocks; nothing in a query tick touches the heap. */
+  static Game g;
+  test_game_init(&g);
+  assert(g.tick_scratch.arena.size >= sizeof(int) * (size_t)g.caps.enemies * TICK_SCRATCH_ENEMY_LISTS);
+  assert(g.frame_scratch.arena.size >= sizeof(int) * (size_t)g.caps.enemies);
+  int hits = alloc_guard_hits();
+  alloc_guard_enter();
+  scratch_reset(&g.tick_scratch);
+  for (int k = 0; k < TICK_SCRATCH_ENEMY_LISTS; k++) assert(SCRATCH_NEW(&g.tick_scratch, int, g.caps.enemies));
+  assert(damage_field_reserve(&g.field));
+  alloc_guard_leave();
+  assert(alloc_guard_hits() == hits && g.tick_scratch.spill_count == 0);
+  game_pools_free(&g);
+  assert(g.field.dps == NULL && g.tick_scratch.arena.base == NULL);
+}
+
+/* A heap allocation reached from update_game is caught, not just scratch
+   spills: with the damage field gone the tick callocs a new one. */
+static void test_alloc_guard_in_tick() {
+  static Game g;
+  test_game_init(&g);
+  assert(db_load(&g.db));
+  g.player.base.max_hp = 100;
+  g.player.hp = 100;
+  g.mode = MODE_WAVE;
+  int prev = alloc_guard_set_fatal(0);
+  int hits = alloc_guard_hits();
+  update_game(&g, 1.0f / 60.0f);
+  assert(alloc_guard_hits() == hits);
+  damage_field_free(&g.field);
+  update_game(&g, 1.0f / 60.0f);
+  assert(alloc_guard_hits() > hits && g.field.dps);
+  assert(g.mode == MODE_WAVE);
+#ifdef BUH_ALLOC_WRAP
+  static void *volatile sink;
+  hits = alloc_guard_hits();
+  alloc_guard_enter();
+  sink = malloc(16);
+  alloc_guard_leave();
+  free(sink);
+  assert(alloc_guard_hits() == hits + 1);
+#endif
+  alloc_guard_set_fatal(prev);
+  db_free(&g.db);
+  game_pools_free(&g);
+}
+
+/* A stack straddling a grid cell corner spreads out; turrets and enemies
+   with nobody nearby stay put, and the toggle turns the pass off. */
+static void test_crowd_separation() {
+  static Game g;
+  test_game_init(&g);
+  assert(db_load(&g.db));
+  int ghost = find_enemy(&g.db, "ghost");
+  int tower = find_enemy(&g.db, "tower");
+  const float cx = 8.0f * ENEMY_GRID_CELL;
+  const float cy = 8.0f * ENEMY_GRID_CELL;
+  for (int i = 0; i < 40; i++) enemy_init(&g, i, ghost, cx + (float)(i % 2), cy);
+  enemy_init(&g, 40, tower, cx + 10.0f, cy + 10.0f);
+  enemy_init(&g, 41, ghost, 3000.0f, 3000.0f);
+
+  g.crowd_disabled = 1;
+  crowd_separate(&g, 1.0f / 60.0f);
+  assert(g.enemies[0].x == cx && g.enemies[1].x == cx + 1.0f && g.crowd_neighbors == 0);
+
+  g.crowd_disabled = 0;
+  for (int t = 0; t < 240; t++) crowd_separate(&g, 1.0f / 60.0f);
+  assert(g.enemies[40].x == cx + 10.0f && g.enemies[40].y == cy + 10.0f);
+  assert(g.enemies[41].x == 3000.0f && g.enemies[41].y == 3000.0f);
+  int stacked = 0;
+  int cells[4] = {0};
+  for (int i = 0; i < 40; i++) {
+    Enemy *a = &g.enemies[i];
+    cells[(a->x >= cx) * 2 + (a->y >= cy)]++;
+    for (int j = i + 1; j < 40; j++) {
+      float dx = a->x - g.enemies[j].x;
+      float dy = a->y - g.enemies[j].y;
+      stacked += dx * dx + dy * dy < 4.0f;
+    }
+  }
+  assert(stacked == 0);
+  for (int q = 0; q < 4; q++) assert(cells[q] > 0);
+  assert(g.crowd_neighbors > 0 && g.crowd_neighbors <= 42 * CROWD_MAX_SCAN);
+
+  /* A horde big enough to take turns moves every enemy a little each tick,
+     not a few of them by several ticks' worth at once. */
+  static float before_x[2 * CROWD_TICK_ENEMIES];
+  static float before_y[2 * CROWD_TICK_ENEMIES];
+  const int n = 2 * CROWD_TICK_ENEMIES;
+  assert(g.caps.enemies >= n);
+  for (int i = 0; i < n; i++) enemy_init(&g, i, ghost, cx + (float)(i % 64) * 4.0f, cy + (float)(i / 64) * 4.0f);
+  for (int t = 0; t < 8; t++) {
+    for (int i = 0; i < n; i++) {
+      before_x[i] = g.enemies[i].x;
+      before_y[i] = g.enemies[i].y;
+    }
+    crowd_separate(&g, 1.0f / 60.0f);
+    int moved = 0;
+    for (int i = 0; i < n; i++) {
+      float dx = g.enemies[i].x - before_x[i];
+      float dy = g.enemies[i].y - before_y[i];
+      assert(dx * dx + dy * dy <= CROWD_MAX_STEP * CROWD_MAX_STEP + 1e-3f);
+      moved += dx != 0.0f || dy != 0.0f;
+    }
+    if (t >= g.crowd_grid.stride) assert(moved > n / 2);
+  }
+  db_free(&g.db);
+  game_pools_free(&g);
+}
+
+static void test_render_interp() {
+  static Game g;
+  test_game_init(&g);
+  assert(db_load(&g.db));
+  int ghost = find_enemy(&g.db, "ghost");
+  for (int i = 0; i < 3; i++) enemy_init(&g, i, ghost, 100.0f, 100.0f);
+  g.player.x = 400.0f;
+  g.player.y = 300.0f;
+  interp_capture(&g);
+
+  g.enemies[0].x = 110.0f;
+  g.enemies[1].gen++; /* slot reused during the tick */
+  g.enemies[1].x = 120.0f;
+  g.enemies[2].x = 100.0f + 2.0f * INTERP_SNAP_DIST;
+  g.player.x = 420.0f;
+
+  interp_set_alpha(&g, 1.0f);
+  scratch_reset(&g.frame_scratch);
+  interp_begin(&g);
+  assert(!g.interp.applied && g.enemies[0].x == 110.0f);
+
+  interp_set_alpha(&g, 0.5f);
+  scratch_reset(&g.frame_scratch);
+  interp_begin(&g);
+  assert(g.interp.applied);
+  assert(g.enemies[0].x == 105.0f && g.enemies[0].y == 100.0f);
+  assert(g.enemies[1].x == 120.0f);
+  assert(g.enemies[2].x == 100.0f + 2.0f * INTERP_SNAP_DIST);
+  assert(g.player.x == 410.0f && g.player.y == 300.0f);
+  interp_end(&g);
+  assert(g.enemies[0].x == 110.0f && g.player.x == 420.0f);
+  db_free(&g.db);
+  game_pools_free(&g);
+}
+
+static size_t read_progress(char *buf, size_t cap) {
+  FILE *f = fopen("data/skill_tree_progress.json", "rb");
+  if (!f) return 0;
+  size_t n = fread(buf, 1, cap, f);
+  fclose(f);
+  return n;
+}
+
+static void test_bench_keeps_progress() {
+  static Game g;
+  static char before[8192];
+  static char after[8192];
+  test_game_init(&g);
+  assert(db_load(&g.db));
+  size_t before_len = read_progress(before, sizeof(before));
+
+  BenchOptions o;
+  char *argv[] = {"buh", "--bench", "ticks=30", "enemies=64"};
+  assert(bench_parse_args(&o, 4, argv));
+  assert(run_benchmark(&g, &o));
+  assert(g.headless);
+  int points = g.skill_tree.points;
+
+  /* A death mid-bench must not award or save anything. */
+  g.level = 10;
+  g.player.hp = 0.0f;
+  g.mode = MODE_WAVE;
+  update_game(&g, 1.0f / 60.0f);
+  assert(g.mode == MODE_GAMEOVER);
+  assert(g.skill_tree.points == points && !g.skill_tree_run_awarded);
+  size_t after_len = read_progress(after, sizeof(after));
+  assert(after_len == before_len && memcmp(before, after, before_len) == 0);
+  db_free(&g.db);
+  game_pools_free(&g);
 }
 
 static void test_json_item_stats_apply() {
@@ -82,6 +829,100 @@ static void test_json_item_stats_apply() {
   apply_item(&p, &db, &db.items[ring_idx], ring_idx);
   Stats total = player_total_stats(&p, &db);
   assert(total.damage >= 0.0f);
+  db_free(&db);
+}
+
+static void test_data_pack_roundtrip() {
+  static Database json_db;
+  static Database pack_db;
+  memset(&json_db, 0, sizeof(json_db));
+  memset(&pack_db, 0, sizeof(pack_db));
+  assert(db_load_json(&json_db));
+  assert(db_write_pack(&json_db, "test_content.pack"));
+  assert(db_load_pack(&pack_db, "test_content.pack", 1));
+  assert(pack_db.from_pack);
+  assert(pack_db.weapon_count == json_db.weapon_count);
+  assert(pack_db.item_count == json_db.item_count);
+  assert(pack_db.enemy_count == json_db.enemy_count);
+  assert(pack_db.character_count == json_db.character_count);
+  assert(memcmp(pack_db.weapons, json_db.weapons, sizeof(WeaponDef) * json_db.weapon_count) == 0);
+  assert(memcmp(pack_db.items, json_db.items, sizeof(ItemDef) * json_db.item_count) == 0);
+  assert(memcmp(pack_db.enemies, json_db.enemies, sizeof(EnemyDef) * json_db.enemy_count) == 0);
+  assert(memcmp(pack_db.characters, json_db.characters, sizeof(CharacterDef) * json_db.character_count) == 0);
+
+  /* A pack from another format version must be refused. */
+  FILE *f = fopen("test_content.pack", "r+b");
+  assert(f);
+  unsigned int bad_version = DATA_PACK_VERSION + 1;
+  fseek(f, 4, SEEK_SET);
+  fwrite(&bad_version, sizeof(bad_version), 1, f);
+  fclose(f);
+  assert(!db_load_pack(&pack_db, "test_content.pack", 0));
+  remove("test_content.pack");
+  db_free(&json_db);
+  db_free(&pack_db);
+}
+
+static void test_asset_registry() {
+  static Game g;
+  test_game_init(&g);
+  assert(db_load(&g.db));
+  assert(game_assets_init(&g, NULL));
+  for (int i = 0; i < TEX_COUNT; i++) assert(g.tex[i] != ASSET_NONE);
+  /* Headless: lookups stay safe and nothing is marked failed. */
+  assert(game_tex(&g, TEX_DAGGER) == NULL);
+  assert(!g.assets.entries[g.tex[TEX_DAGGER]].failed);
+
+  AssetHandle h = g.tex_portrait[0];
+  assert(h != ASSET_NONE);
+  game_assets_enter_menu(&g);
+  game_assets_enter_menu(&g);
+  assert(g.assets.entries[h].refcount == 1);
+  g.selected_character = 0;
+  game_assets_enter_run(&g);
+  assert(g.assets.entries[h].refcount == 0);
+  assert(g.run_walk == g.tex_walk[0]);
+  db_free(&g.db);
+  game_pools_free(&g);
+}
+
+static void test_hot_reload_remap() {
+  static Game g;
+  static Database next;
+  test_game_init(&g);
+  assert(db_load_json(&g.db));
+  assert(g.db.weapon_count >= 2 && g.db.item_count >= 2 && g.db.enemy_count >= 2);
+  g.player.weapons[0].active = 1;
+  g.player.weapons[0].def_index = 0;
+  g.player.passive_items[0] = 0;
+  g.player.passive_items[1] = 1;
+  g.player.passive_count = 2;
+  g.enemies[0].active = 1;
+  g.enemies[0].def_index = 1;
+
+  /* Reversed order, and item 0 removed. */
+  assert(db_copy(&next, &g.db));
+  for (int i = 0; i < g.db.weapon_count; i++) next.weapons[i] = g.db.weapons[g.db.weapon_count - 1 - i];
+  for (int i = 0; i < g.db.enemy_count; i++) next.enemies[i] = g.db.enemies[g.db.enemy_count - 1 - i];
+  for (int i = 1; i < g.db.item_count; i++) next.items[i - 1] = g.db.items[i];
+  next.item_count = g.db.item_count - 1;
+  db_build_index(&next);
+  char weapon_id[64];
+  char item_id[64];
+  char enemy_id[64];
+  snprintf(weapon_id, sizeof(weapon_id), "%s", g.db.weapons[0].id);
+  snprintf(item_id, sizeof(item_id), "%s", g.db.items[1].id);
+  snprintf(enemy_id, sizeof(enemy_id), "%s", g.db.enemies[1].id);
+
+  assert(game_swap_database(&g, &next));
+  assert(strcmp(g.db.weapons[g.player.weapons[0].def_index].id, weapon_id) == 0);
+  assert(g.player.passive_count == 1);
+  assert(strcmp(g.db.items[g.player.passive_items[0]].id, item_id) == 0);
+  assert(g.enemies[0].active);
+  assert(strcmp(g.db.enemies[g.enemies[0].def_index].id, enemy_id) == 0);
+  assert(next.weapons == NULL);
+  db_free(&g.db);
+  game_pools_free(&g);
 }
 
 int main(void) {
@@ -89,6 +930,25 @@ int main(void) {
   test_weapon_upgrade();
   test_stats_scaling();
   test_kill_count();
+  test_debuffs_exact_and_expire();
+  test_swept_bullets();
+  test_hit_dedupe();
+  test_bullet_pools();
+  test_targeting_matches_scan();
+  test_shape_queries_match_brute_force();
+  test_chain_procs_batched();
+  test_damage_field_matches_scan();
+  test_xp_drops_coalesce();
+  test_spawn_director();
+  test_pool_profiles();
+  test_scratch_reset_and_spill();
+  test_alloc_guard_in_tick();
+  test_crowd_separation();
+  test_render_interp();
+  test_bench_keeps_progress();
   test_json_item_stats_apply();
+  test_data_pack_roundtrip();
+  test_asset_registry();
+  test_hot_reload_remap();
   return 0;
 }
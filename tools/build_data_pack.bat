@@ -0,0 +1,19 @@
+@echo off
+rem Validates data/*.json and compiles them into data/content.pack.
+rem Usage: tools\build_data_pack.bat [path\to\buh.exe]
+set BUH_EXE=%1
+if "%BUH_EXE%"=="" set BUH_EXE=build\Release\buh.exe
+python -V >nul 2>&1
+if errorlevel 1 (
+  echo Python not runnable; refusing to pack unvalidated data.
+  exit /b 1
+)
+python tools\validate_data.py
+if errorlevel 1 exit /b 1
+"%BUH_EXE%" --pack data\content.pack
+if errorlevel 1 (
+  echo Pack failed; see log.txt
+  exit /b 1
+)
+echo Wrote data\content.pack
+exit /b 0
@@ -10,6 +10,8 @@ WEAPONS_PATH = os.path.join(DATA_DIR, "weapons.json")
 ITEMS_PATH = os.path.join(DATA_DIR, "items.json")
 ENEMIES_PATH = os.path.join(DATA_DIR, "enemies.json")
 CHARACTERS_PATH = os.path.join(DATA_DIR, "characters.json")
+ASSETS_PATH = os.path.join(DATA_DIR, "assets.json")
+SPAWN_CURVE_PATH = os.path.join(DATA_DIR, "spawn_curve.json")
 
 STATS_KEYS = {
     "damage",
@@ -27,6 +29,10 @@ STATS_KEYS = {
 
 SCALES_ALLOWED = {"damage", "attack_speed", "range", "crit"}
 
+SPAWN_PATTERNS = {"edge", "ring", "swarm", "line"}
+MAX_SPAWN_PHASES = 16
+MAX_SPAWN_PHASE_ENEMIES = 8
+
 
 def load_json(path):
     with open(path, "r", encoding="utf-8") as f:
@@ -232,6 +238,69 @@ def validate_characters(data, weapon_ids, errors):
             err(errors, cpath, f"weapon '{weapon}' not found in weapons.json")
 
 
+def validate_assets(data, errors):
+    path = "data/assets.json"
+    assets = require(data, "assets", path, errors)
+    if assets is None:
+        return
+    if not isinstance(assets, list):
+        err(errors, path, "'assets' must be an array")
+        return
+
+    check_unique_ids(assets, path, errors)
+
+    for idx, asset in enumerate(assets):
+        apath = f"{path}#assets[{idx}]"
+        if not isinstance(asset, dict):
+            err(errors, apath, "entry must be an object")
+            continue
+        val = require(asset, "path", apath, errors)
+        if val is not None and not isinstance(val, str):
+            err(errors, apath, "'path' must be a string")
+        for key in ("preload", "fallback"):
+            if key in asset and not isinstance(asset[key], bool):
+                err(errors, apath, f"'{key}' must be true or false")
+
+
+def validate_spawn_curve(data, enemy_ids, errors):
+    path = "data/spawn_curve.json"
+    phases = require(data, "phases", path, errors)
+    if phases is None:
+        return
+    if not isinstance(phases, list):
+        err(errors, path, "'phases' must be an array")
+        return
+    if len(phases) > MAX_SPAWN_PHASES:
+        err(errors, path, f"at most {MAX_SPAWN_PHASES} phases are loaded")
+
+    last_start = None
+    for idx, phase in enumerate(phases):
+        ppath = f"{path}#phases[{idx}]"
+        if not isinstance(phase, dict):
+            err(errors, ppath, "entry must be an object")
+            continue
+        start = require(phase, "start", ppath, errors)
+        if start is not None:
+            if not is_number(start):
+                err(errors, ppath, "'start' must be a number")
+            elif last_start is not None and start < last_start:
+                err(errors, ppath, "phases must be sorted by 'start'")
+            else:
+                last_start = start
+        for key in ("interval", "batch"):
+            if key in phase and (not is_number(phase[key]) or phase[key] <= 0):
+                err(errors, ppath, f"'{key}' must be a positive number")
+        for name in phase.get("patterns", []):
+            if name not in SPAWN_PATTERNS:
+                err(errors, ppath, f"unknown pattern '{name}'")
+        enemies = phase.get("enemies", [])
+        if len(enemies) > MAX_SPAWN_PHASE_ENEMIES:
+            err(errors, ppath, f"at most {MAX_SPAWN_PHASE_ENEMIES} enemies per phase")
+        for eid in enemies:
+            if eid not in enemy_ids:
+                err(errors, ppath, f"enemy '{eid}' not found in enemies.json")
+
+
 def main():
     errors = []
 
@@ -252,8 +321,10 @@ def main():
     try:
         enemies = load_json(ENEMIES_PATH)
         validate_enemies(enemies, errors)
+        enemy_ids = {e.get("id") for e in enemies.get("enemies", []) if isinstance(e, dict)}
     except Exception as exc:
         err(errors, "data/enemies.json", f"failed to load: {exc}")
+        enemy_ids = set()
 
     try:
         chars = load_json(CHARACTERS_PATH)
@@ -261,6 +332,18 @@ def main():
     except Exception as exc:
         err(errors, "data/characters.json", f"failed to load: {exc}")
 
+    try:
+        assets = load_json(ASSETS_PATH)
+        validate_assets(assets, errors)
+    except Exception as exc:
+        err(errors, "data/assets.json", f"failed to load: {exc}")
+
+    try:
+        curve = load_json(SPAWN_CURVE_PATH)
+        validate_spawn_curve(curve, enemy_ids, errors)
+    except Exception as exc:
+        err(errors, "data/spawn_curve.json", f"failed to load: {exc}")
+
     if errors:
         print("Data validation failed:")
         for msg in errors: